@@ -1,115 +1,93 @@
 #!/usr/bin/env python3
 
-filters = [
-	'filter1Pole',
-	'filter1Pole',	
-	'ladderFilter2Pole',
-	'ladderFilter2Pole',
-	'ladderFilter4Pole',
-	'ladderFilter4Pole',
-	'ladderFilter4Pole',
-	'ladderFilter4Pole',
-	'sallenKeyFilterLpBp',
-	'sallenKeyFilterLpBp',
-	'sallenKeyFilterHp',
-	'sallenKeyFilterHp',
-	'diodeClipper',
-	'diodeClipperAsym',
-]
-
-functions = [
-	'lowpass',
-	'highpass',	
-	'lowpass',
-	'bandpass',
-	'lowpass6',
-	'lowpass12',
-	'lowpass18',
-	'lowpass24',
-	'lowpass',
-	'bandpass',
-	'highpass6',
-	'highpass12',
-	'out',
-	'out',
+# Generates the output taps and the kernel table of TFilterBlock in src/blocks/FilterBlock.hpp
+
+# one entry per mode, in the order of TFilterBlock::getModeLabels()
+# (label, filter, output tap, resonant) for the ODE filters, (label, kind) for the others
+modes = [
+	('1-pole lowpass, 6 dB/Oct (non-resonant)', 'filter1Pole', 'lowpass', False),
+	('1-pole highpass, 6 dB/Oct (non-resonant)', 'filter1Pole', 'highpass', False),
+	('2-pole ladder lowpass, 12 dB/Oct', 'ladderFilter2Pole', 'lowpass', True),
+	('2-pole ladder bandpass, 6 dB/Oct', 'ladderFilter2Pole', 'bandpass', True),
+	('4-pole ladder lowpass, 6 dB/Oct', 'ladderFilter4Pole', 'lowpass6', True),
+	('4-pole ladder lowpass, 12 dB/Oct', 'ladderFilter4Pole', 'lowpass12', True),
+	('4-pole ladder lowpass, 18 dB/Oct', 'ladderFilter4Pole', 'lowpass18', True),
+	('4-pole ladder lowpass, 24 dB/Oct', 'ladderFilter4Pole', 'lowpass24', True),
+	('2-pole Sallen-Key lowpass, 12 dB/Oct', 'sallenKeyFilterLpBp', 'lowpass', True),
+	('2-pole Sallen-Key bandpass, 6 dB/Oct', 'sallenKeyFilterLpBp', 'bandpass', True),
+	('2-pole Sallen-Key highpass, 6 dB/Oct', 'sallenKeyFilterHp', 'highpass6', True),
+	('2-pole Sallen-Key highpass, 12 dB/Oct', 'sallenKeyFilterHp', 'highpass12', True),
+	('Comb Filter (positive feedback)', 'comb'),
+	('Comb Filter (negative feedback)', 'combNegative'),
+	('Diode Clipper (Symmetric)', 'diodeClipper', 'out', True),
+	('Diode Clipper (Asymmetric)', 'diodeClipperAsym', 'out', True),
+	('Bypass', 'bypass'),
+	('Mute', 'mute'),
 ]
 
 integratorTypes = [
-	'_linear',
-	'_ota_tanh',
-	'_ota_alt',
-	'_transistor_tanh',
-	'_transistor_alt',
+	('_linear', 'Linear'),
+	('_ota_tanh', 'OTA_tanh'),
+	('_ota_alt', 'OTA_alt'),
+	('_transistor_tanh', 'Transistor_tanh'),
+	('_transistor_alt', 'Transistor_alt'),
 ]
 
 methods = [
-	'processEuler',
-	'processRK2',
-	'processRK4',
+	'Euler',
+	'RK2',
+	'RK4',
 ]
 
+# the kernels of the modes without ODE filter, (set cutoff and resonance, process block)
+otherKernels = {
+	'comb': ('setCombCutoffAndFeedback', 'processCombBlock'),
+	'combNegative': ('setCombCutoffAndNegativeFeedback', 'processCombBlock'),
+	'bypass': ('setNothing', 'processBypassBlock'),
+	'mute': ('setNothing', 'processMuteBlock'),
+}
 
 
-print("void setCutoffFrequencyAndResonance(float_4 frequency, float_4 resonance)")
-print("{")
-print("\tswitch (switchValue)")
-print("\t{")
-for iFilter in range(len(filters)):
-	for iIntegratorType in range(len(integratorTypes)):
-		for iMethod in range(len(methods)):
-			print("\tcase " + str(iFilter*100 + iIntegratorType*10 + iMethod) + ":")
-		print("\t\t" + filters[iFilter] + integratorTypes[iIntegratorType] + ".setCutoffFreq(frequency);")
-		print("\t\t" + filters[iFilter] + integratorTypes[iIntegratorType] + ".setResonance(resonance);")
-		print("\t\tbreak;")
-print("\t}")
-print("}\n")
-
-
+def tapName(function):
+	return function[0].upper() + function[1:] + 'Tap'
 
-print("float_4 process(float_4 in, float_4 dt)")
-print("{")
-print("\tswitch (switchValue)")
-print("\t{")
-for iFilter in range(len(filters)):
-	for iIntegratorType in range(len(integratorTypes)):
-		for iMethod in range(len(methods)):
-			print("\tcase " + str(iFilter*100 + iIntegratorType*10 + iMethod) + ":")
-			print("\t\t" + filters[iFilter] + integratorTypes[iIntegratorType] + "." + methods[iMethod] + "(in, dt);")
-			print("\t\treturn " + filters[iFilter] + integratorTypes[iIntegratorType] + "." + functions[iFilter] + "();")
-print("\tdefault:")
-print("\t\treturn in;")
-print("\t}")
-print("}\n")
 
+taps = []
+for mode in modes:
+	if len(mode) == 4 and mode[2] not in taps:
+		taps.append(mode[2])
 
+print("// output taps of the ODE filters")
+for tap in taps:
+	print("struct " + tapName(tap) + " { template <typename F> static T out(F& f) { return f." + tap + "(); } };")
+print("")
 
-print("void processBlock(float_4* in, float_4 dt, int oversamplingRate)")
+print("static const Kernels& getKernels(int mode, IntegratorType integratorType)")
 print("{")
-print("\tswitch (switchValue)")
+print("\tstatic const Kernels kernels[" + str(len(modes)) + "][" + str(len(integratorTypes)) + "] = {")
+for mode in modes:
+	print("\t\t// " + mode[0])
+	print("\t\t{")
+	for integratorSuffix, integratorType in integratorTypes:
+		if len(mode) == 4:
+			label, filter, tap, resonant = mode
+			filterClass = filter[0].upper() + filter[1:]
+			filterArgs = filterClass + "<T, IntegratorType::" + integratorType + ">, &TFilterBlock::" + filter + integratorSuffix
+			setter = "setODECutoffAndResonance" if resonant else "setODECutoff"
+			print("\t\t\t{&TFilterBlock::" + setter + "<" + filterArgs + ">, {")
+			for method in methods:
+				print("\t\t\t\t&TFilterBlock::processODEBlock<" + filterArgs + ", getCompiledMethod(Method::" + method + "), " + tapName(tap) + ">,")
+			print("\t\t\t}},")
+		else:
+			setter, processBlock = otherKernels[mode[1]]
+			print("\t\t\t{&TFilterBlock::" + setter + ", {" + ", ".join(["&TFilterBlock::" + processBlock] * len(methods)) + "}},")
+	print("\t\t},")
+print("\t};")
+print("\tstatic const Kernels bypass = {&TFilterBlock::setNothing, {" + ", ".join(["&TFilterBlock::processBypassBlock"] * len(methods)) + "}};")
+print("")
+print("\tif (mode < 0 || mode >= " + str(len(modes)) + " || (int)integratorType < 0 || (int)integratorType >= " + str(len(integratorTypes)) + ")")
 print("\t{")
-for iFilter in range(len(filters)):
-	for iIntegratorType in range(len(integratorTypes)):
-		for iMethod in range(len(methods)):
-			print("\tcase " + str(iFilter*100 + iIntegratorType*10 + iMethod) + ":")
-			
-			print("\t\tfor (int i = 0; i < oversamplingRate; ++i)")
-			print("\t\t{")
-			
-			print("\t\t\t" + filters[iFilter] + integratorTypes[iIntegratorType] + "." + methods[iMethod] + "(in[i], dt);")
-			print("\t\t\tin[i] = " + filters[iFilter] + integratorTypes[iIntegratorType] + "." + functions[iFilter] + "();")
-			
-			print("\t\t}")
-			print("\t\tbreak;")
-print("\tdefault:")
-print("\t\treturn;")
+print("\t\treturn bypass;")
 print("\t}")
-
+print("\treturn kernels[mode][(int)integratorType];")
 print("}")
-
-
-
-
-
-
-
-
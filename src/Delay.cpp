@@ -1,14 +1,17 @@
 #include "plugin.hpp"
+#include "components/DeferredAllocation.hpp"
 #include "dsp/compander.hpp"
 #include "dsp/functions.hpp"
 #include "dsp/odeFilters.hpp"
+#include "dsp/pagedRingBuffer.hpp"
+#include "dsp/random.hpp"
 
 namespace musx {
 
 using namespace rack;
 using simd::float_4;
 
-struct Delay : Module {
+struct Delay : Module, DeferredAllocation {
 	enum ParamId {
 		TIME_PARAM,
 		FEEDBACK_PARAM,
@@ -45,42 +48,155 @@ struct Delay : Module {
 	};
 
 	ParamQuantity* delayTimeQty;
-	int delayLineSize = 4069;
+	int delayLineSize = 4096;
 	float minDelayTime = 1.f * delayLineSize / 256; // ms
 	float maxDelayTime = 100.f * delayLineSize / 256; // ms
 	float logMaxOverMin = std::log(maxDelayTime/minDelayTime); // log(maxDelayTime/minDelayTime)
-	static const int maxDelayLineSize = 16384;
-	float_4 delayLine[maxDelayLineSize] = {0};
+	static const int tapeSizeFactor = 16; // long delay (tape) mode
+	static const int maxDelayLineSize = (1 << 14) * tapeSizeFactor;
+
+	// every channel is a stereo delay, two channels share a float_4 of the BBD (float[0..1] and float[2..3])
+	static const int maxChannels = 16;
+	static const int maxGroups = maxChannels / 2;
+	// the pages of the delay lines are allocated by allocateAndFree(), outside the audio thread
+	musx::TPagePool<float_4> pagePool{16, maxGroups * maxDelayLineSize / musx::TPagePool<float_4>::pageSize};
+	musx::TPagedRingBuffer<float_4> delayLine[maxGroups];
+
+	bool polyphonic = false;
+	bool tape = false;
+	int channels = 1;
 
 	float prevTap = 0;
 	int tapCounter = 0;
 
 	int index = 0;
-	float_4 in = 0;
-	int inN = 0;
-	float_4 out = 0;
-	float_4 outBufferFilter = 0; // float[0..1] is in, [2..3] is out
-	float_4 outBufferSaturator = 0; // float[0..1] is in, [2..3] is out
-	float_4 lastOut = 0;
+	float_4 inSum[maxGroups] = {}; // input integrated since the last BBD clock event
+	float inWeight = 0; // time since the last BBD clock event, in samples
+	float_4 readout[maxGroups] = {}; // bucket at index, after the nonlinearity
 
-	int oversamplingRate = 8;
+	float noiseScale = 0.35f;
 
-	double phasor = 0;
+	float clockPhase = 0; // [0..1), position between two BBD clock events
 
 	static constexpr float minCutoff = 200.f; // Hz
 	static constexpr float maxCutoff = 10000.f; // Hz
 
-	// input/output filter (float[0..1] is in, [2..3] is out)
-	musx::SallenKeyFilterLpBp<float_4> inOutFilter1; // 1 and 2 pole
-	musx::SallenKeyFilterLpBp<float_4> inOutFilter2; // additional filter for 3 and 4 pole
+	/** the parameters and CVs as the audio path uses them, the knobs are read at knobDivider rate */
+	struct Snapshot {
+		// knob rate
+		float inputGain = 0.5f; // including the average of L and R
+		float feedback = 0.35f; // without CV
+		bool invert = false;
+		int poles = 1;
+		float noise = 0.f; // including noiseScale
+		float dry = 1.f;
+		float wetToL[2] = {0.75f, 0.25f}; // from delay line 0 and 1 to the L output
+		float wetToR[2] = {0.25f, 0.75f}; // from delay line 0 and 1 to the R output
+
+		// sample rate
+		float freq = 1.f; // [Hz], 1/delay time
+		float clockInc = 0.f; // BBD clock events per sample
+		float invClockInc = 0.f;
+		float feedbackGain[maxChannels] = {}; // with CV
+	};
+
+	Snapshot snapshot;
+
+	/** the anti-aliasing and reconstruction path of one stereo delay, float[0..1] is in, [2..3] is out */
+	struct Channel {
+		// input/output filter
+		musx::SallenKeyFilterLpBp<float_4> inOutFilter1; // 1 and 2 pole
+		musx::SallenKeyFilterLpBp<float_4> inOutFilter2; // additional filter for 3 and 4 pole
 
-	// compressor
-	musx::TCompander<float_4> compander;
+		// compressor
+		musx::TCompander<float_4> compander;
+
+		// DC block
+		musx::TOnePole<float_4> dcBlocker;
+
+		musx::AntialiasedCheapSaturator<float_4> inOutSaturator;
+
+		float_4 outBufferFilter = 0;
+		float_4 outBufferSaturator = 0;
+		float_4 lastOut = 0;
+
+		/** input of the delay lines, from the input and feedback in float[0..1] */
+		float_4 processInput(float_4 inMono, int poles, float sampleTime)
+		{
+			// saturate
+			inMono[2] = outBufferSaturator[0];
+			inMono[3] = outBufferSaturator[1];
+			inMono = inOutSaturator.process(inMono);
+			outBufferSaturator[2] = inMono[2];
+			outBufferSaturator[3] = inMono[3];
+
+			// compressor
+			inMono = compander.compress(inMono);
+
+			// anti-aliasing filter
+			inMono[2] = outBufferFilter[0];
+			inMono[3] = outBufferFilter[1];
+
+			switch (poles)
+			{
+			case 0:
+				inOutFilter1.process(inMono, sampleTime);
+				inMono = inOutFilter1.lowpass6();
+				break;
+			case 1:
+				inOutFilter1.process(inMono, sampleTime);
+				inMono = inOutFilter1.lowpass();
+				break;
+			case 2:
+				inOutFilter1.process(inMono, sampleTime);
+				inMono = inOutFilter1.lowpass();
+				inOutFilter2.process(inMono, sampleTime);
+				inMono = inOutFilter2.lowpass6();
+				break;
+			case 3:
+				inOutFilter1.process(inMono, sampleTime);
+				inMono = inOutFilter1.lowpass();
+				inOutFilter2.process(inMono, sampleTime);
+				inMono = inOutFilter2.lowpass();
+				break;
+			}
+
+			outBufferFilter[2] = inMono[2];
+			outBufferFilter[3] = inMono[3];
+
+			return inMono;
+		}
+
+		/** wet signal, from the output of the delay lines in float[0..1] */
+		float_4 processOutput(float_4 out)
+		{
+			// DC blocker
+			dcBlocker.process(out);
+			out = dcBlocker.highpass();
 
-	// DC block
-	musx::TOnePole<float_4> dcBlocker;
+			// reconstruction filter
+			outBufferFilter[0] = out[0];
+			outBufferFilter[1] = out[1];
 
-	musx::AntialiasedCheapSaturator<float_4> inOutSaturator;
+			out[0] = outBufferFilter[2];
+			out[1] = outBufferFilter[3];
+
+			// expander
+			out = compander.expand(out);
+
+			// saturate
+			outBufferSaturator[0] = out[0];
+			outBufferSaturator[1] = out[1];
+
+			out[0] = outBufferSaturator[2];
+			out[1] = outBufferSaturator[3];
+
+			lastOut = out;
+			return out;
+		}
+	};
+
+	Channel channel[maxChannels];
 
 	dsp::ClockDivider lightDivider;
 	dsp::ClockDivider knobDivider;
@@ -88,6 +204,8 @@ struct Delay : Module {
 	double tapLightPhasor = 0;
 	musx::TOnePole<float_4> lightFilter;
 
+	musx::Random rng; // BBD noise, independent for all delay lines
+
 	Delay() {
 		config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 		delayTimeQty = configParam(TIME_PARAM, 0.f, 1.f, 0.65f, "Delay time", " ms", maxDelayTime/minDelayTime, minDelayTime);
@@ -127,26 +245,210 @@ struct Delay : Module {
 
 		configBypass(L_INPUT, L_OUTPUT);
 		configBypass(R_INPUT, R_OUTPUT);
+
+		readKnobs();
+
+		for (int g = 0; g < maxGroups; g++)
+		{
+			delayLine[g].setPagePool(&pagePool, maxDelayLineSize);
+			delayLine[g].resize(delayLineSize);
+		}
+		pagePool.refill();
+	}
+
+	void allocateAndFree() override
+	{
+		pagePool.refill();
+	}
+
+	void onAdd(const AddEvent& e) override {
+		Module::onAdd(e);
+		rng.seed(getId());
 	}
 
 	void onSampleRateChange(const SampleRateChangeEvent& e) override {
-		compander.setCompressorCutoffFreq(params[COMPANDER_PARAM].getValue()/e.sampleRate);
-		compander.setExpanderCutoffFreq(params[COMPANDER_PARAM].getValue()/e.sampleRate);
-		dcBlocker.setCutoffFreq(20.f/e.sampleRate);
+		for (int c = 0; c < maxChannels; c++)
+		{
+			channel[c].compander.setCompressorCutoffFreq(params[COMPANDER_PARAM].getValue()/e.sampleRate);
+			channel[c].compander.setExpanderCutoffFreq(params[COMPANDER_PARAM].getValue()/e.sampleRate);
+			channel[c].dcBlocker.setCutoffFreq(20.f/e.sampleRate);
+		}
 		lightFilter.setCutoffFreq(5.f/e.sampleRate*lightDivider.getDivision());
 
-		int factor = std::round(std::log2(46050/e.sampleRate));
-		oversamplingRate = 8 * pow(2, factor);
-		oversamplingRate = std::fmax(1, oversamplingRate);
+		// noise is white at the sample rate, with the level of 8 averaged noise values per sample at 46 kHz
+		noiseScale = std::sqrt(std::fmin(1.f, e.sampleRate / (8.f * 46050.f)));
+	}
+
+	void setChannels(int newChannels)
+	{
+		// release the delay lines of unused channels
+		for (int g = (newChannels + 1) / 2; g < maxGroups; g++)
+		{
+			delayLine[g].clear();
+			inSum[g] = 0;
+			readout[g] = 0;
+		}
+
+		for (int c = channels; c < newChannels; c++)
+		{
+			// clear the delay lines of a channel that shares the group with a channel in use
+			if (c % 2 == 1)
+			{
+				for (int p = 0; p < delayLine[c/2].getPages(); p++)
+				{
+					float_4* page = delayLine[c/2].getPage(p);
+					for (int i = 0; page && i < delayLine[c/2].pageSize; i++)
+					{
+						page[i][2] = 0.f;
+						page[i][3] = 0.f;
+					}
+				}
+			}
+			channel[c].outBufferFilter = 0;
+			channel[c].outBufferSaturator = 0;
+			channel[c].lastOut = 0;
+		}
+		channels = newChannels;
+	}
+
+	/** knob part of the snapshot, with the derived gains */
+	void readKnobs()
+	{
+		snapshot.inputGain = 0.5f * params[INPUT_PARAM].getValue();
+		snapshot.feedback = 0.7f * params[FEEDBACK_PARAM].getValue();
+		snapshot.invert = params[INVERT_PARAM].getValue();
+		snapshot.poles = params[POLES_PARAM].getValue();
+		snapshot.noise = params[NOISE_PARAM].getValue() * noiseScale;
+
+		// L = dry * in L + wet * (width * l + (1 - width) * (l + r) / 2), R likewise
+		float mix = params[MIX_PARAM].getValue();
+		float width = params[STEREO_WIDTH_PARAM].getValue();
+		float wet = std::min(1.f, 2.f * mix);
+		snapshot.dry = std::min(1.f, 2.f - 2.f * mix);
+		snapshot.wetToL[0] = wet * (0.5f + 0.5f * width);
+		snapshot.wetToL[1] = wet * (0.5f - 0.5f * width);
+		if (snapshot.invert)
+		{
+			// chorus mode: R wet signal = - L wet signal
+			snapshot.wetToR[0] = -snapshot.wetToL[0];
+			snapshot.wetToR[1] = -snapshot.wetToL[1];
+		}
+		else
+		{
+			snapshot.wetToR[0] = snapshot.wetToL[1];
+			snapshot.wetToR[1] = snapshot.wetToL[0];
+		}
+	}
+
+	/** the audio path of all channels, only depends on the snapshot */
+	void processAudio(float sampleTime, const float* inL, const float* inR, float* outL, float* outR)
+	{
+		int groups = (channels + 1) / 2;
+		float_4 bbdIn[maxGroups] = {};
+
+		for (int c = 0; c < channels; c++)
+		{
+			float_4 inMono;
+			inMono[0] = (inL[c] + inR[c]) * snapshot.inputGain;
+
+			// feedback
+			if (snapshot.invert)
+			{
+				// chorus mode: feedback from delay line 1
+				inMono[0] += snapshot.feedbackGain[c] * channel[c].lastOut[0];
+			}
+			else
+			{
+				// output of delay line 0 (l) is is input of delay line 1 (r)
+				inMono[0] += snapshot.feedbackGain[c] * channel[c].lastOut[1];
+				inMono[1] = snapshot.feedbackGain[c] * channel[c].lastOut[0];
+			}
+
+			inMono = channel[c].processInput(inMono, snapshot.poles, sampleTime);
+
+			// the two delay lines of this channel
+			bbdIn[c/2][2*(c%2)] = inMono[0];
+			bbdIn[c/2][2*(c%2)+1] = inMono[1];
+		}
+
+		// BBD simulation, only the clock events are computed
+		// in between, the input is averaged and the readout of the last bucket is held
+		float_4 bbdOut[maxGroups];
+		for (int g = 0; g < groups; g++)
+		{
+			bbdOut[g] = 0;
+		}
+		float remaining = 1.f; // of this sample
+		float endPhase;
+		while ((endPhase = clockPhase + snapshot.clockInc * remaining) >= 1.f)
+		{
+			float dt = (1.f - clockPhase) * snapshot.invClockInc; // until the clock event
+			for (int g = 0; g < groups; g++)
+			{
+				inSum[g] += dt * bbdIn[g];
+				bbdOut[g] += dt * readout[g];
+			}
+			inWeight += dt;
+			remaining -= dt;
+
+			// fill bucket, and advance BBD delay line, the next bucket is read out until the next clock event
+			float invInWeight = 1.f / inWeight;
+			int nextIndex = (index + 1) & (delayLineSize-1);
+			for (int g = 0; g < groups; g++)
+			{
+				delayLine[g].write(index, inSum[g] * invInWeight);
+				inSum[g] = 0;
+
+				// nonlinearity
+				readout[g] = musx::waveshape(delayLine[g].read(nextIndex)/5.f)*5.f;
+			}
+			inWeight = 0;
+			index = nextIndex;
+
+			clockPhase = 0.f;
+		}
+		for (int g = 0; g < groups; g++)
+		{
+			inSum[g] += remaining * bbdIn[g];
+			bbdOut[g] += remaining * readout[g];
+
+			// add noise
+			bbdOut[g] += snapshot.noise * rng.normal();
+		}
+		inWeight += remaining;
+		clockPhase = endPhase;
+
+		for (int c = 0; c < channels; c++)
+		{
+			float_4 out = 0;
+			out[0] = bbdOut[c/2][2*(c%2)];
+			out[1] = bbdOut[c/2][2*(c%2)+1];
+
+			out = channel[c].processOutput(out);
+
+			outL[c] = snapshot.dry * inL[c] + snapshot.wetToL[0] * out[0] + snapshot.wetToL[1] * out[1];
+			outR[c] = snapshot.dry * inR[c] + snapshot.wetToR[0] * out[0] + snapshot.wetToR[1] * out[1];
+		}
 	}
 
 	void process(const ProcessArgs& args) override {
 		if (knobDivider.process())
 		{
-			int newDelayLineSize = std::pow(2, params[BBD_SIZE_PARAM].getValue());
+			#ifdef METAMODULE
+			// no module widget steps on MetaModule, so the pages are allocated here
+			allocateAndFree();
+			#endif
+
+			int newDelayLineSize = std::pow(2, params[BBD_SIZE_PARAM].getValue()) * (tape ? tapeSizeFactor : 1);
 			if (newDelayLineSize != delayLineSize)
 			{
+				// the pages beyond the new size are given back, and taken again when the write head gets there
 				delayLineSize = newDelayLineSize;
+				for (int g = 0; g < maxGroups; g++)
+				{
+					delayLine[g].resize(delayLineSize);
+				}
+				index &= delayLineSize-1;
 				minDelayTime = 1.f * delayLineSize / 256;
 				maxDelayTime = 100.f * delayLineSize / 256;
 				logMaxOverMin = std::log(maxDelayTime/minDelayTime);
@@ -154,15 +456,28 @@ struct Delay : Module {
 
 			delayTimeQty->ParamQuantity::displayBase = maxDelayTime/minDelayTime;
 			delayTimeQty->ParamQuantity::displayMultiplier = minDelayTime;
+			getParamQuantity(BBD_SIZE_PARAM)->displayMultiplier = tape ? tapeSizeFactor : 1;
+
+			int newChannels = polyphonic ? std::max(1, std::max(inputs[L_INPUT].getChannels(), inputs[R_INPUT].getChannels())) : 1;
+			if (newChannels != channels)
+			{
+				setChannels(newChannels);
+			}
 
 			// calculate frequencies for anti-aliasing- and reconstruction-filter
 			float_4 cutoffFreq = std::pow(maxCutoff/minCutoff, params[CUTOFF_PARAM].getValue()) * minCutoff; // f_c
 
-			inOutFilter1.setCutoffFreq(cutoffFreq);
-			inOutFilter2.setCutoffFreq(cutoffFreq);
+			for (int c = 0; c < channels; c++)
+			{
+				channel[c].inOutFilter1.setCutoffFreq(cutoffFreq);
+				channel[c].inOutFilter2.setCutoffFreq(cutoffFreq);
 
-			inOutFilter1.setResonance(params[RESONANCE_PARAM].getValue() * 1.6f);
-			inOutFilter2.setResonance(params[RESONANCE_PARAM].getValue() * 1.6f);
+				channel[c].inOutFilter1.setResonance(params[RESONANCE_PARAM].getValue() * 1.6f);
+				channel[c].inOutFilter2.setResonance(params[RESONANCE_PARAM].getValue() * 1.6f);
+
+				channel[c].compander.setCompressorCutoffFreq(params[COMPANDER_PARAM].getValue()/args.sampleRate);
+				channel[c].compander.setExpanderCutoffFreq(params[COMPANDER_PARAM].getValue()/args.sampleRate);
+			}
 
 			// tap tempo
 			++tapCounter;
@@ -178,177 +493,66 @@ struct Delay : Module {
 			}
 			prevTap = params[TAP_PARAM].getValue();
 
-			compander.setCompressorCutoffFreq(params[COMPANDER_PARAM].getValue()/args.sampleRate);
-			compander.setExpanderCutoffFreq(params[COMPANDER_PARAM].getValue()/args.sampleRate);
+			readKnobs();
 		}
 
-		// calculate frequency for BBD clock
+		// calculate frequency for BBD clock, shared by all channels
 		// pow(a, b) = exp(b * log(a))
 		float delayTime = std::exp(logMaxOverMin * simd::clamp(params[TIME_PARAM].getValue() + 0.1f * inputs[TIME_CV_INPUT].getVoltageSum(), 0.f, 1.f)) * minDelayTime; // [ms]
-		float freq = 1.f/delayTime * 1000.f; // [Hz]
-		double phaseInc = 1.f / args.sampleRate * freq / oversamplingRate * 2 * delayLineSize;
+		snapshot.freq = 1.f/delayTime * 1000.f; // [Hz]
+		snapshot.clockInc = snapshot.freq * delayLineSize * args.sampleTime;
+		snapshot.invClockInc = 1.f / snapshot.clockInc;
 
 		// inputs
-		float inL = inputs[L_INPUT].getVoltageSum();
-		float inR = inputs[R_INPUT].isConnected() ? inputs[R_INPUT].getVoltageSum() : inL;
-
-		float_4 inMono;
-		inMono[0] = 0.5f * (inL + inR) * params[INPUT_PARAM].getValue();
-
-		// feedback
-		if (params[INVERT_PARAM].getValue())
+		float inL[maxChannels];
+		float inR[maxChannels];
+		if (polyphonic)
 		{
-			// chorus mode: feedback from delay line 1
-			inMono[0] += 0.7f * (params[FEEDBACK_PARAM].getValue() + 0.3f * inputs[FEEDBACK_CV_INPUT].getVoltageSum()) * lastOut[0];
+			for (int c = 0; c < channels; c++)
+			{
+				inL[c] = inputs[L_INPUT].getPolyVoltage(c);
+				inR[c] = inputs[R_INPUT].isConnected() ? inputs[R_INPUT].getPolyVoltage(c) : inL[c];
+				snapshot.feedbackGain[c] = snapshot.feedback + 0.7f * 0.3f * inputs[FEEDBACK_CV_INPUT].getPolyVoltage(c);
+			}
 		}
 		else
 		{
-			// output of delay line 0 (l) is is input of delay line 1 (r)
-			inMono[0] += 0.7f * (params[FEEDBACK_PARAM].getValue() + 0.3f * inputs[FEEDBACK_CV_INPUT].getVoltageSum()) * lastOut[1];
-			inMono[1] = 0.7f * (params[FEEDBACK_PARAM].getValue() + 0.3f * inputs[FEEDBACK_CV_INPUT].getVoltageSum()) * lastOut[0];
+			inL[0] = inputs[L_INPUT].getVoltageSum();
+			inR[0] = inputs[R_INPUT].isConnected() ? inputs[R_INPUT].getVoltageSum() : inL[0];
+			snapshot.feedbackGain[0] = snapshot.feedback + 0.7f * 0.3f * inputs[FEEDBACK_CV_INPUT].getVoltageSum();
 		}
 
-		// saturate
-		inMono[2] = outBufferSaturator[0];
-		inMono[3] = outBufferSaturator[1];
-		inMono = inOutSaturator.process(inMono);
-		outBufferSaturator[2] = inMono[2];
-		outBufferSaturator[3] = inMono[3];
-
-		// compressor
-		inMono = compander.compress(inMono);
-
-		// anti-aliasing filter
-		inMono[2] = outBufferFilter[0];
-		inMono[3] = outBufferFilter[1];
+		float outL[maxChannels];
+		float outR[maxChannels];
+		processAudio(args.sampleTime, inL, inR, outL, outR);
 
-		switch ((int)params[POLES_PARAM].getValue())
+		outputs[L_OUTPUT].setChannels(channels);
+		outputs[R_OUTPUT].setChannels(channels);
+		for (int c = 0; c < channels; c++)
 		{
-		case 0:
-			inOutFilter1.process(inMono, args.sampleTime);
-			inMono = inOutFilter1.lowpass6();
-			break;
-		case 1:
-			inOutFilter1.process(inMono, args.sampleTime);
-			inMono = inOutFilter1.lowpass();
-			break;
-		case 2:
-			inOutFilter1.process(inMono, args.sampleTime);
-			inMono = inOutFilter1.lowpass();
-			inOutFilter2.process(inMono, args.sampleTime);
-			inMono = inOutFilter2.lowpass6();
-			break;
-		case 3:
-			inOutFilter1.process(inMono, args.sampleTime);
-			inMono = inOutFilter1.lowpass();
-			inOutFilter2.process(inMono, args.sampleTime);
-			inMono = inOutFilter2.lowpass();
-			break;
+			outputs[L_OUTPUT].setVoltage(outL[c], c);
+			outputs[R_OUTPUT].setVoltage(outR[c], c);
 		}
 
-		outBufferFilter[2] = inMono[2];
-		outBufferFilter[3] = inMono[3];
-
-
-		out = 0;
-		// oversampled BBD simulation
-		for (int i = 0; i < oversamplingRate; ++i)
-		{
-			// simple average over input
-			in += inMono;
-			++inN;
-
-			// readout
-			float_4 readout = delayLine[index];
-
-			// add noise
-			readout += params[NOISE_PARAM].getValue() * random::normal();
-
-			// nonlinearity
-			readout = musx::waveshape(readout/5.f)*5.f;
-
-			out += readout;
-
-			// bbd
-			if (phasor + phaseInc > 1.f)
+		// Light
+		if (lightDivider.process()) {
+			float overload = 0.f;
+			for (int c = 0; c < channels; c++)
 			{
-				// fill bucket
-				delayLine[index] = in/inN;
-
-				// reset input averager
-				in = 0;
-				inN = 0;
-
-				// advance BBD delay line
-				++index;
-				index &= delayLineSize-1;
-
-				phasor -= 2.f;
+				overload = std::max(overload, channel[c].compander.compressorAmplitude()[0]);
 			}
 
-			phasor += phaseInc;
-		}
-
-		// simple average over output
-		out /= oversamplingRate;
-
-		// DC blocker
-		dcBlocker.process(out);
-		out = dcBlocker.highpass();
-
-		// reconstruction filter
-		outBufferFilter[0] = out[0];
-		outBufferFilter[1] = out[1];
-
-		out[0] = outBufferFilter[2];
-		out[1] = outBufferFilter[3];
-
-		// expander
-		out = compander.expand(out);
-
-		// saturate
-		outBufferSaturator[0] = out[0];
-		outBufferSaturator[1] = out[1];
-
-		out[0] = outBufferSaturator[2];
-		out[1] = outBufferSaturator[3];
-
-
-		lastOut = out;
-
-		// L R
-		float outMono = 0.5f * (out[0] + out[1]);
-		float outL = out[0] * params[STEREO_WIDTH_PARAM].getValue() + (1. - params[STEREO_WIDTH_PARAM].getValue()) * outMono;
-		float outR = out[1] * params[STEREO_WIDTH_PARAM].getValue() + (1. - params[STEREO_WIDTH_PARAM].getValue()) * outMono;
-
-		outputs[L_OUTPUT].setVoltage(std::min(1.f, (2.f - 2.f * params[MIX_PARAM].getValue())) * inL +
-				std::min(1.f, 2.f * params[MIX_PARAM].getValue()) * outL);
-
-		if (params[INVERT_PARAM].getValue())
-		{
-			// chorus mode
-			outputs[R_OUTPUT].setVoltage(std::min(1.f, (2.f - 2.f * params[MIX_PARAM].getValue())) * inR -
-								std::min(1.f, 2.f * params[MIX_PARAM].getValue()) * outL);
-		}
-		else
-		{
-			outputs[R_OUTPUT].setVoltage(std::min(1.f, (2.f - 2.f * params[MIX_PARAM].getValue())) * inR +
-					std::min(1.f, 2.f * params[MIX_PARAM].getValue()) * outR);
-		}
-
-		// Light
-		if (lightDivider.process()) {
-			double tapPhaseInc = 1.f / args.sampleRate * freq * 2 * lightDivider.getDivision();
+			double tapPhaseInc = 1.f / args.sampleRate * snapshot.freq * 2 * lightDivider.getDivision();
 			tapLightPhasor += tapPhaseInc;
 			tapLightPhasor = tapLightPhasor > 1.f ? tapLightPhasor - 2.f : tapLightPhasor;
 			float_4 lightSignal = {
 					float(tapLightPhasor > 0.f),
-					compander.compressorAmplitude()[0],
+					overload,
 					0, 0};
 			lightFilter.process(lightSignal);
 
 			float tapBrightness = 0.5;
-			if (freq < 60.f)
+			if (snapshot.freq < 60.f)
 			{
 				tapBrightness = lightFilter.lowpass()[0];
 			}
@@ -361,7 +565,27 @@ struct Delay : Module {
 			}
 			lights[OVERLOAD_LIGHT].setBrightness(overloadBrightness);
 
-			lights[INVERT_LIGHT].setBrightness(params[INVERT_PARAM].getValue());
+			lights[INVERT_LIGHT].setBrightness(snapshot.invert);
+		}
+	}
+
+	json_t* dataToJson() override {
+		json_t* rootJ = json_object();
+		json_object_set_new(rootJ, "polyphonic", json_boolean(polyphonic));
+		json_object_set_new(rootJ, "tape", json_boolean(tape));
+		return rootJ;
+	}
+
+	void dataFromJson(json_t* rootJ) override {
+		json_t* polyphonicJ = json_object_get(rootJ, "polyphonic");
+		if (polyphonicJ)
+		{
+			polyphonic = json_boolean_value(polyphonicJ);
+		}
+		json_t* tapeJ = json_object_get(rootJ, "tape");
+		if (tapeJ)
+		{
+			tape = json_boolean_value(tapeJ);
 		}
 	}
 };
@@ -405,6 +629,38 @@ struct DelayWidget : ModuleWidget {
 		addOutput(createOutputCentered<ThemedPJ301MPort>(mm2px(Vec(38.312, 112.438)), module, Delay::L_OUTPUT));
 		addOutput(createOutputCentered<ThemedPJ301MPort>(mm2px(Vec(53.552, 112.438)), module, Delay::R_OUTPUT));
 	}
+
+	void step() override {
+		if (module)
+		{
+			getModule<Delay>()->allocateAndFree();
+		}
+		ModuleWidget::step();
+	}
+
+	void appendContextMenu(Menu* menu) override {
+		Delay* module = getModule<Delay>();
+
+		menu->addChild(new MenuSeparator);
+
+		menu->addChild(createBoolMenuItem("Polyphonic", "",
+			[=]() {
+				return module->polyphonic;
+			},
+			[=](int mode) {
+				module->polyphonic = mode;
+			}
+		));
+
+		menu->addChild(createBoolMenuItem("Long delays (16x BBD size)", "",
+			[=]() {
+				return module->tape;
+			},
+			[=](int mode) {
+				module->tape = mode;
+			}
+		));
+	}
 };
 
 
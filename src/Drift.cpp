@@ -59,6 +59,16 @@ struct Drift : Module {
 		randomizeDiverge();
 	}
 
+	void onAdd(const AddEvent& e) override
+	{
+		Module::onAdd(e);
+		// the same drift when the patch is loaded again
+		for (int c = 0; c < 16; c += 4)
+		{
+			driftBlock[c/4].seed(getId(), c/4);
+		}
+	}
+
 	void randomizeDiverge()
 	{
 		for (int c = 0; c < 16; c += 4)
@@ -1,6 +1,7 @@
 #include "plugin.hpp"
 #include <math.hpp>
 #include "blocks/FilterBlock.hpp"
+#include "components/DeferredAllocation.hpp"
 #include "dsp/decimator.hpp"
 #include "dsp/functions.hpp"
 
@@ -9,7 +10,7 @@ namespace musx {
 using namespace rack;
 using simd::float_4;
 
-struct Filter : Module {
+struct Filter : Module, DeferredAllocation {
 	enum ParamId {
 		CUTOFF_PARAM,
 		RESONANCE_PARAM,
@@ -42,11 +43,19 @@ struct Filter : Module {
 	int oversamplingRate = 4;
 	#endif
 	HalfBandDecimatorCascade<float_4> decimator[4];
+	bool iirDecimator = false;
+	bool newIIRDecimator = false;
 
 	int channels = 1;
+	float sampleRate = 48000.f;
 
+	// the method and integrator type replace the filters, so they are set in the audio thread
 	Method method = Method::RK2;
+	Method newMethod = Method::RK2;
+	bool methodPending = false;
 	IntegratorType integratorType = IntegratorType::Transistor_tanh;
+	IntegratorType newIntegratorType = IntegratorType::Transistor_tanh;
+	bool integratorTypePending = false;
 	musx::FilterBlock filterBlock[4];
 	float_4 prevInput[4] = {0};
 
@@ -68,62 +77,146 @@ struct Filter : Module {
 
 	void setMethod(Method m)
 	{
-		method = m;
+		newMethod = m;
+		methodPending = true;
+		// set later in audio thread
+	}
+
+	void onSampleRateChange(const SampleRateChangeEvent& e) override
+	{
+		sampleRate = e.sampleRate;
+		setOversamplingRate(oversamplingRate);
+	}
+
+	void setOversamplingRate(int arg)
+	{
+		oversamplingRate = arg;
 		for (int c = 0; c < 16; c += 4)
 		{
-			filterBlock[c/4].setMethod(method);
+			filterBlock[c/4].setSampleTime(1.f / (sampleRate * oversamplingRate));
 		}
 	}
 
-	void setIntegratorType(IntegratorType t)
+	void allocateAndFree() override
 	{
-		integratorType = t;
 		for (int c = 0; c < 16; c += 4)
 		{
-			filterBlock[c/4].setIntegratorType(integratorType);
+			filterBlock[c/4].updateDelayLine();
 		}
 	}
 
-	void process(const ProcessArgs& args) override {
+	void setIIRDecimator(bool arg)
+	{
+		newIIRDecimator = arg;
+		// set later in audio thread
+	}
 
-		channels = std::max(1, inputs[IN_INPUT].getChannels());
-		outputs[OUT_OUTPUT].setChannels(channels);
+	void setIntegratorType(IntegratorType t)
+	{
+		newIntegratorType = t;
+		integratorTypePending = true;
+		// set later in audio thread
+	}
 
-		for (int c = 0; c < channels; c += 4) {
-			// set cutoff
-			float_4 voltage = params[CUTOFF_PARAM].getValue() + 0.1f * inputs[CUTOFF_INPUT].getPolyVoltageSimd<float_4>(c);
-			float_4 frequency = simd::exp(logBase * voltage) * minFreq;
-			frequency = simd::clamp(frequency, minFreq, simd::fmin(2.f * maxFreq, args.sampleRate * oversamplingRate * 0.18f));
+	typedef void (Filter::*ProcessChannels)(const ProcessArgs& args, int c);
 
-			// resonance
-			float_4 resonance = 5. * (params[RESONANCE_PARAM].getValue() + 0.1f * inputs[RESONANCE_INPUT].getPolyVoltageSimd<float_4>(c));
+	void process(const ProcessArgs& args) override {
 
-			int mode = (int)params[MODE_PARAM].getValue();
-			filterBlock[c/4].setMode(mode);
-			filterBlock[c/4].setCutoffFrequencyAndResonance(frequency, resonance);
+		if (methodPending)
+		{
+			methodPending = false;
+			method = newMethod;
+			for (int c = 0; c < 16; c += 4)
+			{
+				filterBlock[c/4].setMethod(method);
+			}
+		}
 
-			// process
-			float_4* inBuffer = decimator[c/4].getInputArray(oversamplingRate);
-			for (int i = 0; i < oversamplingRate; ++i)
+		if (integratorTypePending)
+		{
+			integratorTypePending = false;
+			integratorType = newIntegratorType;
+			for (int c = 0; c < 16; c += 4)
 			{
-				// linear interpolation for input
-				inBuffer[i] = crossfade(prevInput[c/4], inputs[IN_INPUT].getVoltageSimd<float_4>(c), (i + 1.f)/oversamplingRate);
+				filterBlock[c/4].setIntegratorType(integratorType);
 			}
+		}
 
-			filterBlock[c/4].processBlock(inBuffer, args.sampleTime / oversamplingRate, oversamplingRate);
+		#ifdef METAMODULE
+		// no module widget steps on MetaModule, so the comb filter delay lines are allocated here
+		allocateAndFree();
+		#endif
 
-			if (saturate)
+		if (newIIRDecimator != iirDecimator)
+		{
+			iirDecimator = newIIRDecimator;
+			for (int c = 0; c < 16; c += 4)
 			{
-				saturator[c/4].processBlockBandlimited(inBuffer, oversamplingRate);
+				decimator[c/4].setIIR(iirDecimator);
 			}
+		}
+
+		channels = std::max(1, inputs[IN_INPUT].getChannels());
+		outputs[OUT_OUTPUT].setChannels(channels);
 
-			prevInput[c/4] = inputs[IN_INPUT].getVoltageSimd<float_4>(c);
+		static const ProcessChannels processChannelsTable[] = {
+			&Filter::processChannels<1>,
+			&Filter::processChannels<2>,
+			&Filter::processChannels<4>,
+			&Filter::processChannels<8>,
+			&Filter::processChannels<16>,
+			&Filter::processChannels<0>
+		};
+		ProcessChannels processChannelsForRate = processChannelsTable[getOversamplingRateIndex(oversamplingRate)];
 
-			// downsampling
-			float_4 out = decimator[c/4].process(oversamplingRate);
+		for (int c = 0; c < channels; c += 4) {
+			(this->*processChannelsForRate)(args, c);
+		}
+	}
+
+	/**
+	 * filter channels c to c + 3
+	 * OSR is the oversampling rate known at compile time, so that the loops over the oversampled samples can be unrolled,
+	 * 0 for any other oversampling rate
+	 */
+	template <int OSR>
+	void processChannels(const ProcessArgs& args, int c)
+	{
+		const int rate = OSR ? OSR : oversamplingRate;
+
+		// set cutoff
+		float_4 voltage = params[CUTOFF_PARAM].getValue() + 0.1f * inputs[CUTOFF_INPUT].getPolyVoltageSimd<float_4>(c);
+		float_4 frequency = fastExp(logBase * voltage) * minFreq;
+		frequency = simd::clamp(frequency, minFreq, simd::fmin(2.f * maxFreq, args.sampleRate * rate * 0.18f));
+
+		// resonance
+		float_4 resonance = 5. * (params[RESONANCE_PARAM].getValue() + 0.1f * inputs[RESONANCE_INPUT].getPolyVoltageSimd<float_4>(c));
 
-			outputs[OUT_OUTPUT].setVoltageSimd(out, c);
+		int mode = (int)params[MODE_PARAM].getValue();
+		filterBlock[c/4].setMode(mode);
+		filterBlock[c/4].setCutoffFrequencyAndResonance(frequency, resonance);
+
+		// process
+		float_4* inBuffer = decimator[c/4].getInputArray(rate);
+		for (int i = 0; i < rate; ++i)
+		{
+			// linear interpolation for input
+			inBuffer[i] = crossfade(prevInput[c/4], inputs[IN_INPUT].getVoltageSimd<float_4>(c), (i + 1.f)/rate);
 		}
+
+		filterBlock[c/4].processBlock(inBuffer, args.sampleTime / rate, rate);
+
+		if (saturate)
+		{
+			saturator[c/4].processBlockBandlimited(inBuffer, rate);
+		}
+
+		prevInput[c/4] = inputs[IN_INPUT].getVoltageSimd<float_4>(c);
+
+		// downsampling
+		float_4 out = decimator[c/4].process(rate);
+
+		outputs[OUT_OUTPUT].setVoltageSimd(out, c);
 	}
 
 
@@ -134,8 +227,9 @@ struct Filter : Module {
 		json_object_set_new(rootJ, "filterMode", json_string(labels[params[MODE_PARAM].getValue()].c_str()));
 
 		json_object_set_new(rootJ, "oversamplingRate", json_integer(oversamplingRate));
-		json_object_set_new(rootJ, "method", json_integer((int)method));
-		json_object_set_new(rootJ, "integratorType", json_integer((int)integratorType));
+		json_object_set_new(rootJ, "iirDecimator", json_boolean(newIIRDecimator));
+		json_object_set_new(rootJ, "method", json_integer((int)newMethod));
+		json_object_set_new(rootJ, "integratorType", json_integer((int)newIntegratorType));
 		json_object_set_new(rootJ, "saturate", json_boolean(saturate));
 		return rootJ;
 	}
@@ -156,7 +250,12 @@ struct Filter : Module {
 		json_t* oversamplingRateJ = json_object_get(rootJ, "oversamplingRate");
 		if (oversamplingRateJ)
 		{
-			oversamplingRate = json_integer_value(oversamplingRateJ);
+			setOversamplingRate(json_integer_value(oversamplingRateJ));
+		}
+		json_t* iirDecimatorJ = json_object_get(rootJ, "iirDecimator");
+		if (iirDecimatorJ)
+		{
+			setIIRDecimator(json_boolean_value(iirDecimatorJ));
 		}
 		json_t* methodJ = json_object_get(rootJ, "method");
 		if (methodJ)
@@ -200,6 +299,14 @@ struct FilterWidget : ModuleWidget {
 		addOutput(createOutputCentered<ThemedPJ301MPort>(mm2px(Vec(7.62, 112.438)), module, Filter::OUT_OUTPUT));
 	}
 
+	void step() override {
+		if (module)
+		{
+			getModule<Filter>()->allocateAndFree();
+		}
+		ModuleWidget::step();
+	}
+
 	void appendContextMenu(Menu* menu) override {
 		Filter* module = getModule<Filter>();
 
@@ -210,13 +317,22 @@ struct FilterWidget : ModuleWidget {
 				return log2(module->oversamplingRate);
 			},
 			[=](int mode) {
-				module->oversamplingRate = std::pow(2, mode);
+				module->setOversamplingRate(std::pow(2, mode));
+			}
+		));
+
+		menu->addChild(createIndexSubmenuItem("Decimator", {"Linear phase (FIR)", "Low latency (IIR)"},
+			[=]() {
+				return (int)module->newIIRDecimator;
+			},
+			[=](int mode) {
+				module->setIIRDecimator(mode);
 			}
 		));
 
 		menu->addChild(createIndexSubmenuItem("ODE Solver", FilterBlock::getOdeSolverLabels(),
 			[=]() {
-				return (int)module->method;
+				return (int)module->newMethod;
 			},
 			[=](int mode) {
 				module->setMethod((Method)mode);
@@ -225,7 +341,7 @@ struct FilterWidget : ModuleWidget {
 
 		menu->addChild(createIndexSubmenuItem("Integrator type", FilterBlock::getIntegratorTypeLabels(),
 			[=]() {
-				return (int)module->integratorType;
+				return (int)module->newIntegratorType;
 			},
 			[=](int mode) {
 				module->setIntegratorType((IntegratorType)mode);
@@ -1,5 +1,6 @@
 #include "plugin.hpp"
 #include "blocks/LFOBlock.hpp"
+#include "dsp/random.hpp"
 
 namespace musx {
 
@@ -36,6 +37,8 @@ struct LFO : Module {
 	int sampleRateReduction = 1;
 	dsp::ClockDivider divider;
 
+	musx::Random rng; // sample & hold
+
 	LFO() {
 		config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 		configSwitch(SHAPE_PARAM, 0.f, LFOBlock::getShapeLabels().size() - 1, 0.f, "Shape", LFOBlock::getShapeLabels());
@@ -49,6 +52,12 @@ struct LFO : Module {
 		configOutput(OUT_OUTPUT, "LFO");
 	}
 
+	void onAdd(const AddEvent& e) override
+	{
+		Module::onAdd(e);
+		rng.seed(getId());
+	}
+
 	void onSampleRateChange(const SampleRateChangeEvent& e) override
 	{
 		for (int c = 0; c < 16; c += 4)
@@ -81,7 +90,7 @@ struct LFO : Module {
 
 			outputs[OUT_OUTPUT].setChannels(channels);
 
-			float rand = rack::random::uniform(); // 0..1
+			float rand = rng.uniform()[0]; // 0..1
 			float_4 rand4 = {rand, rand, rand, rand};
 
 			for (int c = 0; c < channels; c += 4) {
@@ -1,4 +1,5 @@
 #include "plugin.hpp"
+#include <cstring>
 
 namespace musx {
 
@@ -290,6 +291,15 @@ struct ModMatrix : Module {
 	std::vector<std::vector<Param*>> matrix;
 	std::vector<Output*> outs;
 
+	// dense copy of the matrix params, the last row are the control knob base values
+	// they are updated at the control rate, and ramped to at the audio rate
+	alignas(16) float coefficients[rows + 1][columns] = {};
+	alignas(16) float targetCoefficients[rows + 1][columns] = {};
+	alignas(16) float coefficientSteps[rows + 1][columns] = {};
+	int rampFrames = 0;
+	size_t connectedRows[rows];
+	size_t nConnectedRows = 0;
+
 	std::vector<Param*> controlKnobs;
 	std::vector<float> controlKnobBaseValues; // 'base' values of the control knobs when not controlling other rows
 	std::vector<float> currentControlKnobValues;
@@ -305,7 +315,6 @@ struct ModMatrix : Module {
 	bool relative = false; // relative midi control mode
 
 	dsp::ClockDivider controlDivider;
-	dsp::ClockDivider matrixDivider;
 
 	ModMatrix() {
 		config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
@@ -357,7 +366,6 @@ struct ModMatrix : Module {
 		configOutput(_KNOB_CURRENT_VALUES_OUTPUT, "Current control knob values");
 
 		controlDivider.setDivision(1);
-		matrixDivider.setDivision(1);
 	}
 
 	void setPolarity()
@@ -383,11 +391,61 @@ struct ModMatrix : Module {
 		}
 	}
 
+	/** new targets, reached in one control interval */
+	void updateCoefficients()
+	{
+		nConnectedRows = 0;
+		for (size_t i = 0; i < rows; i++)
+		{
+			if (ins[i]->isConnected())
+			{
+				connectedRows[nConnectedRows++] = i;
+			}
+			for (size_t j = 0; j < columns; j++)
+			{
+				targetCoefficients[i][j] = matrix[i][j]->getValue();
+			}
+		}
+		for (size_t j = 0; j < columns; j++)
+		{
+			targetCoefficients[rows][j] = controlKnobBaseValues[j];
+		}
+
+		// usually nothing changed
+		if (std::memcmp(targetCoefficients, coefficients, sizeof(coefficients)) == 0)
+		{
+			rampFrames = 0;
+			return;
+		}
+
+		float invFrames = 1.f / sampleRateReduction;
+		for (size_t i = 0; i < rows + 1; i++)
+		{
+			for (size_t j = 0; j < columns; j++)
+			{
+				coefficientSteps[i][j] = (targetCoefficients[i][j] - coefficients[i][j]) * invFrames;
+			}
+		}
+		rampFrames = sampleRateReduction;
+	}
+
+	void rampCoefficients()
+	{
+		--rampFrames;
+		for (size_t i = 0; i < rows + 1; i++)
+		{
+			for (size_t j = 0; j < columns; j++)
+			{
+				// the last step lands exactly on the target
+				coefficients[i][j] = rampFrames ? coefficients[i][j] + coefficientSteps[i][j] : targetCoefficients[i][j];
+			}
+		}
+	}
+
 	void setSampleRateReduction(int arg)
 	{
 		sampleRateReduction = arg;
 		controlDivider.setDivision(sampleRateReduction);
-		matrixDivider.setDivision(sampleRateReduction);
 	}
 
 	void onReset(const ResetEvent& e) override
@@ -566,6 +624,8 @@ struct ModMatrix : Module {
 				previousMidiControlKnobValues[j] = midiControlKnobValues[j];
 				previousControlKnobValues[j] = currentControlKnobValues[j];
 			}
+
+			updateCoefficients();
 		}
 
 		// knob values output
@@ -576,30 +636,46 @@ struct ModMatrix : Module {
 		}
 
 		//
-		// calc matrix
+		// calc matrix, at the audio rate with the ramped coefficients
 		//
-		if (matrixDivider.process())
+		if (rampFrames > 0)
 		{
-			for (int c = 0; c < channels; c += 4) {
-				// loop over outs
+			rampCoefficients();
+		}
+
+		// control knob base values, the same for all channels
+		float base[columns];
+		for (size_t j = 0; j < columns; j++)
+		{
+			float value = inputs[_0_INPUT].isConnected() ? inputs[_0_INPUT].getPolyVoltage(j) :
+					bipolar ? 5. : 10.;
+			base[j] = value * coefficients[rows][j];
+		}
+
+		for (int c = 0; c < channels; c += 4) {
+			// all outs at once, one lane per channel
+			float_4 val[columns];
+			for (size_t j = 0; j < columns; j++)
+			{
+				val[j] = base[j];
+			}
+
+			// loop over ins, multiply with params
+			for (size_t k = 0; k < nConnectedRows; k++)
+			{
+				size_t i = connectedRows[k];
+				float_4 in = ins[i]->getPolyVoltageSimd<float_4>(c);
 				for (size_t j = 0; j < columns; j++)
 				{
-					Output* out = outs[j];
-					if (out->isConnected())
-					{
-						// loop over ins, multiply with params
-						float_4 val = inputs[_0_INPUT].isConnected() ? inputs[_0_INPUT].getPolyVoltage(j) :
-								bipolar ? 5. : 10.;
-						val *= controlKnobBaseValues[j];
-
-						for (size_t i = 0; i < rows; i++)
-						{
-							Input* in = ins[i];
-							val += in->getPolyVoltageSimd<float_4>(c) * matrix[i][j]->getValue();
-						}
-
-						out->setVoltageSimd(simd::clamp(val, -12.f, 12.f), c);
-					}
+					val[j] += in * coefficients[i][j];
+				}
+			}
+
+			for (size_t j = 0; j < columns; j++)
+			{
+				if (outs[j]->isConnected())
+				{
+					outs[j]->setVoltageSimd(simd::clamp(val[j], -12.f, 12.f), c);
 				}
 			}
 		}
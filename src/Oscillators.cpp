@@ -58,6 +58,8 @@ struct Oscillators : Module {
 	size_t actualOversamplingRate = oversamplingRate;
 
 	HalfBandDecimatorCascade<float_4> decimator[4];
+	bool iirDecimator = false;
+	bool newIIRDecimator = false;
 
 	int channels = 1;
 
@@ -120,17 +122,43 @@ struct Oscillators : Module {
 		}
 	}
 
+	void setIIRDecimator(bool arg)
+	{
+		newIIRDecimator = arg;
+		// set later in audio thread
+	}
+
 	void setLfoMode(int mode)
 	{
 		lfoMode = mode;
 		actualOversamplingRate = lfoMode? 1 : oversamplingRate;
 	}
 
+	typedef void (Oscillators::*ProcessOversampled)(int c);
+
 	void process(const ProcessArgs& args) override {
+		if (newIIRDecimator != iirDecimator)
+		{
+			iirDecimator = newIIRDecimator;
+			for (int c = 0; c < 16; c += 4) {
+				decimator[c/4].setIIR(iirDecimator);
+			}
+		}
+
 		channels = std::max(1, inputs[OSC1VOCT_INPUT].getChannels());
 		channels = std::max(channels, inputs[OSC2VOCT_INPUT].getChannels());
 		outputs[OUT_OUTPUT].setChannels(channels);
 
+		static const ProcessOversampled processOversampledTable[] = {
+			&Oscillators::processOversampled<1>,
+			&Oscillators::processOversampled<2>,
+			&Oscillators::processOversampled<4>,
+			&Oscillators::processOversampled<8>,
+			&Oscillators::processOversampled<16>,
+			&Oscillators::processOversampled<0>
+		};
+		ProcessOversampled processOversampledForRate = processOversampledTable[getOversamplingRateIndex(actualOversamplingRate)];
+
 		for (int c = 0; c < channels; c += 4) {
 
 			// parameters and CVs
@@ -161,58 +189,72 @@ struct Oscillators : Module {
 			}
 
 
-			// calculate the oversampled oscillators
-			float_4* inBuffer = decimator[c/4].getInputArray(actualOversamplingRate);
+			(this->*processOversampledForRate)(c);
+		}
 
-			if (antiAliasing)
-			{
-				oscBlock[c/4].processBandlimited(inBuffer);
-			}
-			else
+		// Light
+		if (lightDivider.process()) {
+			lights[SYNC_LIGHT].setBrightness(params[SYNC_PARAM].getValue());
+		}
+	}
+
+	/**
+	 * oscillators, DC blocker, saturator and decimator of channels c to c + 3
+	 * OSR is the oversampling rate known at compile time, so that the loops over the oversampled samples can be unrolled,
+	 * 0 for any other oversampling rate
+	 */
+	template <int OSR>
+	void processOversampled(int c)
+	{
+		const int rate = OSR ? OSR : actualOversamplingRate;
+
+		// calculate the oversampled oscillators
+		float_4* inBuffer = decimator[c/4].getInputArray(rate);
+
+		if (antiAliasing)
+		{
+			oscBlock[c/4].processBandlimited<OSR>(inBuffer);
+		}
+		else
+		{
+			oscBlock[c/4].process<OSR>(inBuffer);
+		}
+
+		// dc blocker and saturator
+		bool calcDcBlock = dcBlock && !lfoMode;
+		for (int i = 0; i < rate; ++i)
+		{
+			// DC blocker
+			if (calcDcBlock)
 			{
-				oscBlock[c/4].process(inBuffer);
+				dcBlocker[c/4].process(inBuffer[i]);
+				inBuffer[i] = dcBlocker[c/4].highpass();
 			}
 
-			// dc blocker and saturator
-			bool calcDcBlock = dcBlock && !lfoMode;
-			for (size_t i = 0; i < actualOversamplingRate; ++i)
+			// saturator +-13V
+			if (saturate)
 			{
-				// DC blocker
-				if (calcDcBlock)
+				if (antiAliasing)
 				{
-					dcBlocker[c/4].process(inBuffer[i]);
-					inBuffer[i] = dcBlocker[c/4].highpass();
+					inBuffer[i] = saturator[c/4].processBandlimited(inBuffer[i]);
 				}
-
-				// saturator +-13V
-				if (saturate)
+				else
 				{
-					if (antiAliasing)
-					{
-						inBuffer[i] = saturator[c/4].processBandlimited(inBuffer[i]);
-					}
-					else
-					{
-						inBuffer[i] = saturator[c/4].processNonBandlimited(inBuffer[i]);
-					}
+					inBuffer[i] = saturator[c/4].processNonBandlimited(inBuffer[i]);
 				}
 			}
-
-			// downsampling
-			float_4 out = decimator[c/4].process(actualOversamplingRate);
-
-			outputs[OUT_OUTPUT].setVoltageSimd(out, c);
 		}
 
-		// Light
-		if (lightDivider.process()) {
-			lights[SYNC_LIGHT].setBrightness(params[SYNC_PARAM].getValue());
-		}
+		// downsampling
+		float_4 out = decimator[c/4].process(rate);
+
+		outputs[OUT_OUTPUT].setVoltageSimd(out, c);
 	}
 
 	json_t* dataToJson() override {
 		json_t* rootJ = json_object();
 		json_object_set_new(rootJ, "oversamplingRate", json_integer(oversamplingRate));
+		json_object_set_new(rootJ, "iirDecimator", json_boolean(newIIRDecimator));
 		json_object_set_new(rootJ, "antiAliasing", json_boolean(antiAliasing));
 		json_object_set_new(rootJ, "dcBlock", json_boolean(dcBlock));
 		json_object_set_new(rootJ, "saturate", json_boolean(saturate));
@@ -226,6 +268,11 @@ struct Oscillators : Module {
 		{
 			setOversamplingRate(json_integer_value(oversamplingRateJ));
 		}
+		json_t* iirDecimatorJ = json_object_get(rootJ, "iirDecimator");
+		if (iirDecimatorJ)
+		{
+			setIIRDecimator(json_boolean_value(iirDecimatorJ));
+		}
 		json_t* antiAliasingJ = json_object_get(rootJ, "antiAliasing");
 		if (antiAliasingJ)
 		{
@@ -301,6 +348,15 @@ struct OscillatorsWidget : ModuleWidget {
 			}
 		));
 
+		menu->addChild(createIndexSubmenuItem("Decimator", {"Linear phase (FIR)", "Low latency (IIR)"},
+			[=]() {
+				return (int)module->newIIRDecimator;
+			},
+			[=](int mode) {
+				module->setIIRDecimator(mode);
+			}
+		));
+
 		menu->addChild(createBoolMenuItem("Anti-aliasing", "",
 			[=]() {
 				return module->antiAliasing;
@@ -1,4 +1,4 @@
-#include "plugin.hpp"
+#include "SplitStack.hpp"
 
 namespace musx {
 
@@ -40,12 +40,34 @@ struct SplitStack : Module {
 		LIGHTS_LEN
 	};
 
+	static constexpr int maxZones = SplitStackMessage::maxZones;
+
 	float lastSplitParamValue = 0.f;
 	bool split = false;
 	bool learnedSplitPoint = false;
-	float splitPoint = 0.f;
 	float_4 oldGates[4] = {0.f};
 
+	// zones A, B, and one for every expander on the right that is not a layer
+	int zones = 2;
+	dsp::ClockDivider zonesDivider;
+
+	// sorted, the first zones - 1 are used, zone z is from boundaries[z - 1] to boundaries[z]
+	float boundaries[maxZones - 1];
+	int learnIndex = 0;
+
+	// in split mode, the zone of every voice
+	float_4 voiceZones[4] = {0.f};
+
+	// voice compaction: in split mode, every voice gets the lowest free channel of its zone when its gate goes high,
+	// and keeps it until the channel is needed by another voice
+	bool compactVoices = false;
+	bool lastCompactVoices = false;
+	bool voiceGates[16] = {false};
+	int compactZones[16];
+	int compactChannels[16];
+	int channelVoices[maxZones][16];
+	int zoneChannels[maxZones];
+
 	SplitStack() {
 		config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 		configSwitch(STACK_PARAM, 0.f, 1.f, 0.f, "Stack A+B", {"off", "on"});
@@ -66,11 +88,154 @@ struct SplitStack : Module {
 		configOutput(AFT_B_OUTPUT, "Aftertouch B");
 		configOutput(RETRIG_A_OUTPUT, "Retrigger A");
 		configOutput(RETRIG_B_OUTPUT, "Retrigger B");
+
+		for (int b = 0; b < maxZones - 1; b++)
+		{
+			// C4, C5, ...
+			boundaries[b] = b;
+		}
+
+		zonesDivider.setDivision(512);
+
+		resetVoices();
+	}
+
+	void resetVoices() {
+		for (int c = 0; c < 16; c++)
+		{
+			voiceGates[c] = false;
+			compactZones[c] = -1;
+			compactChannels[c] = -1;
+		}
+		for (int z = 0; z < maxZones; z++)
+		{
+			for (int k = 0; k < 16; k++)
+			{
+				channelVoices[z][k] = -1;
+			}
+			zoneChannels[z] = 0;
+		}
+	}
+
+	/** lowest channel of zone whose voice is released, or a new channel */
+	int allocateChannel(int zone) {
+		for (int k = 0; k < zoneChannels[zone]; k++)
+		{
+			int voice = channelVoices[zone][k];
+			if (voice < 0 || !voiceGates[voice])
+			{
+				return k;
+			}
+		}
+		// at most 16 gates are held, so there is always a free channel
+		return zoneChannels[zone]++;
+	}
+
+	/** count the expanders on the right, and keep the used boundaries sorted */
+	void updateZones() {
+		int newZones = 2;
+		for (Module* m = rightExpander.module; m && m->model == modelSplitStackExpander && newZones < maxZones; m = m->rightExpander.module)
+		{
+			if (!static_cast<SplitStackExpander*>(m)->layer)
+			{
+				newZones++;
+			}
+		}
+
+		if (newZones != zones)
+		{
+			zones = newZones;
+			learnIndex = 0;
+			std::sort(boundaries, boundaries + zones - 1);
+			resetVoices();
+		}
+	}
+
+	/** zone of every voice, by counting the boundaries at or below its pitch */
+	void updateVoiceZones(int channels) {
+		bool switched = params[SWITCH_PARAM].getValue();
+
+		for (int c = 0; c < channels; c += 4) {
+			float_4 voct = inputs[VOCT_INPUT].getPolyVoltageSimd<float_4>(c);
+			float_4 zone = 0.f;
+			for (int b = 0; b < zones - 1; b++)
+			{
+				zone += (voct >= boundaries[b]) & 1.f;
+			}
+			voiceZones[c/4] = switched ? (zones - 1) - zone : zone;
+		}
+	}
+
+	void processCompactSplit(int channels) {
+		if (!lastCompactVoices)
+		{
+			resetVoices();
+			lastCompactVoices = true;
+		}
+
+		for (int c = 0; c < channels; c++)
+		{
+			bool gate = inputs[GATE_INPUT].getVoltage(c) >= 1.f;
+			if (gate && !voiceGates[c])
+			{
+				// new note, the zone is chosen once, so the voice does not jump zones while it is held
+				int zone = voiceZones[c/4][c%4];
+
+				// retriggered voices keep their channel
+				voiceGates[c] = true;
+				int k = compactZones[c] == zone ? compactChannels[c] : allocateChannel(zone);
+
+				if (compactZones[c] >= 0 && compactZones[c] != zone)
+				{
+					channelVoices[compactZones[c]][compactChannels[c]] = -1;
+				}
+				int previousVoice = channelVoices[zone][k];
+				if (previousVoice >= 0 && previousVoice != c)
+				{
+					// steal the channel from a released voice
+					compactZones[previousVoice] = -1;
+					compactChannels[previousVoice] = -1;
+				}
+				channelVoices[zone][k] = c;
+				compactZones[c] = zone;
+				compactChannels[c] = k;
+			}
+			voiceGates[c] = gate;
+		}
+
+		for (int c = channels; c < 16; c++)
+		{
+			voiceGates[c] = false;
+		}
+
+		for (int side = 0; side < 2; side++)
+		{
+			// A and B outputs alternate, in the same order as the inputs
+			for (int i = 0; i < INPUTS_LEN; i++)
+			{
+				Output& output = outputs[2 * i + side];
+				output.channels = zoneChannels[side];
+				for (int k = 0; k < zoneChannels[side]; k++)
+				{
+					int voice = channelVoices[side][k];
+					output.setVoltage(voice >= 0 && voice < channels ? inputs[i].getVoltage(voice) : 0.f, k);
+				}
+			}
+		}
+
+		for (int c = 0; c < channels; c += 4) {
+			oldGates[c/4] = inputs[GATE_INPUT].getPolyVoltageSimd<float_4>(c);
+		}
 	}
 
 	void process(const ProcessArgs& args) override {
 		int channels = inputs[VOCT_INPUT].getChannels();
 
+		if (zonesDivider.process())
+		{
+			updateZones();
+		}
+
 		lights[SWITCH_LIGHT].setBrightness(params[SWITCH_PARAM].getValue());
 
 		if (params[STACK_PARAM].getValue())
@@ -121,7 +286,12 @@ struct SplitStack : Module {
 					params[STACK_PARAM].setValue(0.f);
 				}
 			}
+			else
+			{
+				std::sort(boundaries, boundaries + zones - 1);
+			}
 			learnedSplitPoint = false;
+			learnIndex = 0;
 		}
 
 		lastSplitParamValue = params[SPLIT_PARAM].getValue();
@@ -139,45 +309,60 @@ struct SplitStack : Module {
 			for (int c = 0; c < channels; c += 1) {
 				float gate = inputs[GATE_INPUT].getVoltage(c);
 
+				// with more than 2 zones, the notes set the boundaries one after the other, they are sorted when the button is released
 				if (gate > oldGates[c/4][c%4] + 1.f)
 				{
-					splitPoint = inputs[VOCT_INPUT].getVoltage(c);
+					boundaries[learnIndex] = inputs[VOCT_INPUT].getVoltage(c);
+					learnIndex = (learnIndex + 1) % (zones - 1);
 					learnedSplitPoint = true;
-					break;
 				}
 			}
 		}
 
 		if (split)
+		{
+			updateVoiceZones(channels);
+		}
+
+		if (split && compactVoices)
+		{
+			processCompactSplit(channels);
+		}
+		else
+		{
+			// start with empty channels when compaction is turned on again
+			lastCompactVoices = false;
+		}
+
+		if (split && !compactVoices)
 		{
 			// split
 			for (int c = 0; c < channels; c += 4) {
-				float_4 mask = params[SWITCH_PARAM].getValue() ?
-						inputs[VOCT_INPUT].getPolyVoltageSimd<float_4>(c) < splitPoint :
-						inputs[VOCT_INPUT].getPolyVoltageSimd<float_4>(c) >= splitPoint;
+				float_4 maskA = voiceZones[c/4] == 0.f;
+				float_4 mask = voiceZones[c/4] == 1.f;
 
 				outputs[VOCT_A_OUTPUT].channels = channels;
-				outputs[VOCT_A_OUTPUT].setVoltageSimd(~mask & inputs[VOCT_INPUT].getPolyVoltageSimd<float_4>(c), c);
+				outputs[VOCT_A_OUTPUT].setVoltageSimd(maskA & inputs[VOCT_INPUT].getPolyVoltageSimd<float_4>(c), c);
 				outputs[VOCT_B_OUTPUT].channels = channels;
 				outputs[VOCT_B_OUTPUT].setVoltageSimd(mask & inputs[VOCT_INPUT].getPolyVoltageSimd<float_4>(c), c);
 
 				outputs[GATE_A_OUTPUT].channels = channels;
-				outputs[GATE_A_OUTPUT].setVoltageSimd(~mask & inputs[GATE_INPUT].getPolyVoltageSimd<float_4>(c), c);
+				outputs[GATE_A_OUTPUT].setVoltageSimd(maskA & inputs[GATE_INPUT].getPolyVoltageSimd<float_4>(c), c);
 				outputs[GATE_B_OUTPUT].channels = channels;
 				outputs[GATE_B_OUTPUT].setVoltageSimd(mask & inputs[GATE_INPUT].getPolyVoltageSimd<float_4>(c), c);
 
 				outputs[VEL_A_OUTPUT].channels = channels;
-				outputs[VEL_A_OUTPUT].setVoltageSimd(~mask & inputs[VEL_INPUT].getPolyVoltageSimd<float_4>(c), c);
+				outputs[VEL_A_OUTPUT].setVoltageSimd(maskA & inputs[VEL_INPUT].getPolyVoltageSimd<float_4>(c), c);
 				outputs[VEL_B_OUTPUT].channels = channels;
 				outputs[VEL_B_OUTPUT].setVoltageSimd(mask & inputs[VEL_INPUT].getPolyVoltageSimd<float_4>(c), c);
 
 				outputs[AFT_A_OUTPUT].channels = channels;
-				outputs[AFT_A_OUTPUT].setVoltageSimd(~mask & inputs[AFT_INPUT].getPolyVoltageSimd<float_4>(c), c);
+				outputs[AFT_A_OUTPUT].setVoltageSimd(maskA & inputs[AFT_INPUT].getPolyVoltageSimd<float_4>(c), c);
 				outputs[AFT_B_OUTPUT].channels = channels;
 				outputs[AFT_B_OUTPUT].setVoltageSimd(mask & inputs[AFT_INPUT].getPolyVoltageSimd<float_4>(c), c);
 
 				outputs[RETRIG_A_OUTPUT].channels = channels;
-				outputs[RETRIG_A_OUTPUT].setVoltageSimd(~mask & inputs[RETRIG_INPUT].getPolyVoltageSimd<float_4>(c), c);
+				outputs[RETRIG_A_OUTPUT].setVoltageSimd(maskA & inputs[RETRIG_INPUT].getPolyVoltageSimd<float_4>(c), c);
 				outputs[RETRIG_B_OUTPUT].channels = channels;
 				outputs[RETRIG_B_OUTPUT].setVoltageSimd(mask & inputs[RETRIG_INPUT].getPolyVoltageSimd<float_4>(c), c);
 
@@ -243,6 +428,70 @@ struct SplitStack : Module {
 				}
 			}
 		}
+
+		// the expanders write their outputs themselves, so this does not depend on the number of zones
+		if (rightExpander.module && rightExpander.module->model == modelSplitStackExpander)
+		{
+			SplitStackMessage* message = (SplitStackMessage*) rightExpander.module->leftExpander.producerMessage;
+			writeMessage(message, channels);
+			rightExpander.module->leftExpander.requestMessageFlip();
+		}
+	}
+
+	void writeMessage(SplitStackMessage* message, int channels) {
+		message->mode = split ? SplitStackMessage::SPLIT : params[STACK_PARAM].getValue() ? SplitStackMessage::STACK : SplitStackMessage::NORMAL;
+		message->channels = channels;
+		message->zone = 1;
+		message->zones = zones;
+		message->switched = params[SWITCH_PARAM].getValue();
+		message->compactVoices = compactVoices;
+		std::copy(boundaries, boundaries + maxZones - 1, message->boundaries);
+
+		for (int c = 0; c < channels; c += 4) {
+			for (int i = 0; i < INPUTS_LEN; i++)
+			{
+				message->voltages[i][c/4] = inputs[i].getPolyVoltageSimd<float_4>(c);
+			}
+			message->voiceZones[c/4] = voiceZones[c/4];
+		}
+
+		if (split && compactVoices)
+		{
+			std::copy(compactZones, compactZones + 16, message->compactZones);
+			std::copy(compactChannels, compactChannels + 16, message->compactChannels);
+			std::copy(zoneChannels, zoneChannels + maxZones, message->zoneChannels);
+		}
+	}
+
+	json_t* dataToJson() override {
+		json_t* rootJ = json_object();
+		json_object_set_new(rootJ, "compactVoices", json_boolean(compactVoices));
+
+		json_t* boundariesJ = json_array();
+		for (int b = 0; b < maxZones - 1; b++)
+		{
+			json_array_append_new(boundariesJ, json_real(boundaries[b]));
+		}
+		json_object_set_new(rootJ, "boundaries", boundariesJ);
+
+		return rootJ;
+	}
+
+	void dataFromJson(json_t* rootJ) override {
+		json_t* compactVoicesJ = json_object_get(rootJ, "compactVoices");
+		if (compactVoicesJ)
+		{
+			compactVoices = json_boolean_value(compactVoicesJ);
+		}
+
+		json_t* boundariesJ = json_object_get(rootJ, "boundaries");
+		if (boundariesJ)
+		{
+			for (int b = 0; b < maxZones - 1 && b < (int)json_array_size(boundariesJ); b++)
+			{
+				boundaries[b] = json_number_value(json_array_get(boundariesJ, b));
+			}
+		}
 	}
 };
 
@@ -280,6 +529,21 @@ struct SplitStackWidget : ModuleWidget {
 
 	}
 
+	void appendContextMenu(Menu* menu) override {
+		SplitStack* module = getModule<SplitStack>();
+
+		menu->addChild(new MenuSeparator);
+
+		menu->addChild(createBoolMenuItem("Compact split voices", "",
+			[=]() {
+				return module->compactVoices;
+			},
+			[=](int mode) {
+				module->compactVoices = mode;
+			}
+		));
+	}
+
 	void draw(const DrawArgs& args) override {
 		ModuleWidget::draw(args);
 
@@ -296,56 +560,13 @@ struct SplitStackWidget : ModuleWidget {
 			nvgFillColor(args.vg, SCHEME_GREEN);
 
 			// Generate your text
-			std::string text = "";
 			float splitPointVOct = 0.f;
-			if (getModule<SplitStack>())
+			SplitStack* module = getModule<SplitStack>();
+			if (module)
 			{
-				splitPointVOct = getModule<SplitStack>()->splitPoint;
+				splitPointVOct = getZoneBoundary(module->boundaries, module->zones, module->params[SplitStack::SWITCH_PARAM].getValue(), 1);
 			}
-
-			// get note
-			switch ((int)((splitPointVOct - floorf(splitPointVOct) + 1.f/24.f) * 12.f))
-			{
-			case 0:
-				text.append("C ");
-				break;
-			case 1:
-				text.append("C#");
-				break;
-			case 2:
-				text.append("D ");
-				break;
-			case 3:
-				text.append("Eb");
-				break;
-			case 4:
-				text.append("E ");
-				break;
-			case 5:
-				text.append("F ");
-				break;
-			case 6:
-				text.append("F#");
-				break;
-			case 7:
-				text.append("G ");
-				break;
-			case 8:
-				text.append("G#");
-				break;
-			case 9:
-				text.append("A ");
-				break;
-			case 10:
-				text.append("Bb");
-				break;
-			case 11:
-				text.append("B ");
-				break;
-			}
-
-			// get octave
-			text.append(std::to_string((int)(splitPointVOct + 4 + 1.f/24.f)));
+			std::string text = getNoteName(splitPointVOct);
 
 			// Draw the text at a position
 			nvgText(args.vg, 102, 101, text.c_str(), NULL);
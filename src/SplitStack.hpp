@@ -0,0 +1,99 @@
+#pragma once
+
+#include "plugin.hpp"
+
+namespace musx {
+
+using namespace rack;
+using simd::float_4;
+
+/**
+ * What SplitStack sends to the chain of expanders on its right.
+ * Every expander passes it on to the next one, so each expander adds one sample of latency.
+ */
+struct SplitStackMessage {
+	static constexpr int maxZones = 8;
+	static constexpr int inputs = 5;
+
+	enum Mode {
+		NORMAL,
+		STACK,
+		SPLIT
+	};
+
+	Mode mode = NORMAL;
+	int channels = 0;
+
+	// zone of the sending module, the last zone of SplitStack is 1 (B)
+	int zone = 1;
+	int zones = 2;
+	bool switched = false;
+	bool compactVoices = false;
+
+	// sorted, zones - 1 are used
+	float boundaries[maxZones - 1] = {0.f};
+
+	// in split mode, the zone of every voice
+	float_4 voiceZones[4];
+
+	// with compaction, the zone and channel of every voice, and the number of channels of every zone
+	int compactZones[16];
+	int compactChannels[16];
+	int zoneChannels[maxZones] = {0};
+
+	float_4 voltages[inputs][4];
+};
+
+/** expander that adds one more zone to SplitStack, or a layer of the zone on its left */
+struct SplitStackExpander : Module {
+	enum ParamId {
+		PARAMS_LEN
+	};
+	enum InputId {
+		INPUTS_LEN
+	};
+	enum OutputId {
+		VOCT_OUTPUT,
+		GATE_OUTPUT,
+		VEL_OUTPUT,
+		AFT_OUTPUT,
+		RETRIG_OUTPUT,
+		OUTPUTS_LEN
+	};
+	enum LightId {
+		LIGHTS_LEN
+	};
+
+	SplitStackMessage messages[2];
+
+	bool layer = false;
+
+	// for the display, -1 if there is no SplitStack on the left
+	int zone = -1;
+	float boundary = 0.f;
+
+	SplitStackExpander();
+
+	void process(const ProcessArgs& args) override;
+
+	json_t* dataToJson() override;
+	void dataFromJson(json_t* rootJ) override;
+};
+
+/** the boundary between zone and the zone on its left */
+inline float getZoneBoundary(const float* boundaries, int zones, bool switched, int zone)
+{
+	return switched ? boundaries[zones - 1 - zone] : boundaries[zone - 1];
+}
+
+/** note name and octave, e.g. "C#4" */
+inline std::string getNoteName(float voct)
+{
+	static const char* names[] = {"C ", "C#", "D ", "Eb", "E ", "F ", "F#", "G ", "G#", "A ", "Bb", "B "};
+
+	std::string text = names[(int)((voct - floorf(voct) + 1.f/24.f) * 12.f) % 12];
+	text.append(std::to_string((int)(voct + 4 + 1.f/24.f)));
+	return text;
+}
+
+}
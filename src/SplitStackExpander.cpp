@@ -0,0 +1,183 @@
+#include "SplitStack.hpp"
+
+namespace musx {
+
+using namespace rack;
+using simd::float_4;
+
+SplitStackExpander::SplitStackExpander() {
+	config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
+	configOutput(VOCT_OUTPUT, "V/Oct");
+	configOutput(GATE_OUTPUT, "Gate");
+	configOutput(VEL_OUTPUT, "Velocity");
+	configOutput(AFT_OUTPUT, "Aftertouch");
+	configOutput(RETRIG_OUTPUT, "Retrigger");
+
+	leftExpander.producerMessage = &messages[0];
+	leftExpander.consumerMessage = &messages[1];
+}
+
+void SplitStackExpander::process(const ProcessArgs& args) {
+	static const SplitStackMessage emptyMessage = SplitStackMessage();
+
+	bool connected = leftExpander.module && (leftExpander.module->model == modelSplitStack || leftExpander.module->model == modelSplitStackExpander);
+	const SplitStackMessage* message = connected ? (const SplitStackMessage*) leftExpander.consumerMessage : &emptyMessage;
+
+	zone = -1;
+	if (connected && message->zone >= 0)
+	{
+		zone = layer ? message->zone : message->zone + 1;
+	}
+
+	int channels = 0;
+	if (zone >= 0 && zone < message->zones)
+	{
+		boundary = getZoneBoundary(message->boundaries, message->zones, message->switched, zone);
+
+		switch (message->mode)
+		{
+		case SplitStackMessage::STACK:
+			channels = message->channels;
+			for (int i = 0; i < OUTPUTS_LEN; i++)
+			{
+				outputs[i].channels = channels;
+				for (int c = 0; c < channels; c += 4) {
+					outputs[i].setVoltageSimd(message->voltages[i][c/4], c);
+				}
+			}
+			break;
+		case SplitStackMessage::SPLIT:
+			if (message->compactVoices)
+			{
+				channels = message->zoneChannels[zone];
+				for (int i = 0; i < OUTPUTS_LEN; i++)
+				{
+					outputs[i].channels = channels;
+					for (int k = 0; k < channels; k++)
+					{
+						outputs[i].setVoltage(0.f, k);
+					}
+					for (int c = 0; c < message->channels; c++)
+					{
+						if (message->compactZones[c] == zone)
+						{
+							outputs[i].setVoltage(message->voltages[i][c/4][c%4], message->compactChannels[c]);
+						}
+					}
+				}
+			}
+			else
+			{
+				channels = message->channels;
+				for (int c = 0; c < channels; c += 4) {
+					float_4 mask = message->voiceZones[c/4] == float_4(zone);
+					for (int i = 0; i < OUTPUTS_LEN; i++)
+					{
+						outputs[i].channels = channels;
+						outputs[i].setVoltageSimd(mask & message->voltages[i][c/4], c);
+					}
+				}
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	if (!channels)
+	{
+		for (int i = 0; i < OUTPUTS_LEN; i++)
+		{
+			outputs[i].channels = 0;
+		}
+	}
+
+	// pass the message on
+	if (rightExpander.module && rightExpander.module->model == modelSplitStackExpander)
+	{
+		SplitStackMessage* next = (SplitStackMessage*) rightExpander.module->leftExpander.producerMessage;
+		*next = *message;
+		next->zone = zone;
+		rightExpander.module->leftExpander.requestMessageFlip();
+	}
+}
+
+json_t* SplitStackExpander::dataToJson() {
+	json_t* rootJ = json_object();
+	json_object_set_new(rootJ, "layer", json_boolean(layer));
+	return rootJ;
+}
+
+void SplitStackExpander::dataFromJson(json_t* rootJ) {
+	json_t* layerJ = json_object_get(rootJ, "layer");
+	if (layerJ)
+	{
+		layer = json_boolean_value(layerJ);
+	}
+}
+
+
+struct SplitStackExpanderWidget : ModuleWidget {
+	SplitStackExpanderWidget(SplitStackExpander* module) {
+		setModule(module);
+		setPanel(createPanel(asset::plugin(pluginInstance, "res/SplitStackExpander.svg"), asset::plugin(pluginInstance, "res/SplitStackExpander-dark.svg")));
+
+		addChild(createWidget<ThemedScrew>(Vec(RACK_GRID_WIDTH, 0)));
+		addChild(createWidget<ThemedScrew>(Vec(box.size.x - 2 * RACK_GRID_WIDTH, RACK_GRID_HEIGHT - RACK_GRID_WIDTH)));
+
+		addOutput(createOutputCentered<ThemedPJ301MPort>(mm2px(Vec(10.16, 51.456)), module, SplitStackExpander::VOCT_OUTPUT));
+		addOutput(createOutputCentered<ThemedPJ301MPort>(mm2px(Vec(10.16, 66.46)), module, SplitStackExpander::GATE_OUTPUT));
+		addOutput(createOutputCentered<ThemedPJ301MPort>(mm2px(Vec(10.16, 81.465)), module, SplitStackExpander::VEL_OUTPUT));
+		addOutput(createOutputCentered<ThemedPJ301MPort>(mm2px(Vec(10.16, 96.469)), module, SplitStackExpander::AFT_OUTPUT));
+		addOutput(createOutputCentered<ThemedPJ301MPort>(mm2px(Vec(10.16, 111.473)), module, SplitStackExpander::RETRIG_OUTPUT));
+	}
+
+	void appendContextMenu(Menu* menu) override {
+		SplitStackExpander* module = getModule<SplitStackExpander>();
+
+		menu->addChild(new MenuSeparator);
+
+		menu->addChild(createBoolMenuItem("Layer with the zone on the left", "",
+			[=]() {
+				return module->layer;
+			},
+			[=](int mode) {
+				module->layer = mode;
+			}
+		));
+	}
+
+	void draw(const DrawArgs& args) override {
+		ModuleWidget::draw(args);
+
+		SplitStackExpander* module = getModule<SplitStackExpander>();
+		if (!module || module->zone < 0)
+		{
+			return;
+		}
+
+		std::string fontPath = asset::system("res/fonts/DejaVuSans.ttf");
+		std::shared_ptr<Font> font = APP->window->loadFont(fontPath);
+		if (font) {
+			nvgFontFaceId(args.vg, font->handle);
+			nvgTextAlign(args.vg, NVG_ALIGN_CENTER | NVG_ALIGN_BASELINE);
+
+			// boundary to the zone on the left
+			nvgFontSize(args.vg, 16.0);
+			nvgFillColor(args.vg, SCHEME_GREEN);
+			std::string text = module->layer ? "layer" : getNoteName(module->boundary);
+			nvgText(args.vg, box.size.x / 2, 101, text.c_str(), NULL);
+
+			// zone name, A and B are on SplitStack
+			nvgFontSize(args.vg, 13.0);
+			nvgFillColor(args.vg, nvgRGB(0xf9, 0xf9, 0xf9));
+			text = std::string(1, 'A' + module->zone);
+			nvgText(args.vg, box.size.x / 2, 134, text.c_str(), NULL);
+		}
+	}
+};
+
+
+Model* modelSplitStackExpander = createModel<SplitStackExpander, SplitStackExpanderWidget>("SplitStackExpander");
+
+}
@@ -0,0 +1,2730 @@
+#pragma once
+
+#include "plugin.hpp"
+#include "components/componentLibrary.hpp"
+#include "components/DeferredAllocation.hpp"
+#include "components/ModuleWithCustomParamContextMenu.hpp"
+#include "components/WorkerPool.hpp"
+
+#include "blocks/ADSRBlock.hpp"
+#include "blocks/DriftBlock.hpp"
+#include "blocks/FilterBlock.hpp"
+#include "blocks/LFOBlock.hpp"
+#include "blocks/OscillatorsBlock.hpp"
+
+#include "dsp/decimator.hpp"
+#include "dsp/filters.hpp"
+#include "dsp/random.hpp"
+
+#include <array>
+
+namespace musx {
+
+using namespace rack;
+
+struct Synth : ModuleWithCustomParamContextMenu, DeferredAllocation {
+	enum ParamId {
+		// assign params
+		VOCT_ASSIGN_PARAM,
+		GATE_ASSIGN_PARAM,
+		VELOCITY_ASSIGN_PARAM,
+		AFTERTOUCH_ASSIGN_PARAM,
+		PITCH_WHEEL_ASSIGN_PARAM,
+		MOD_WHEEL_ASSIGN_PARAM,
+		EXPRESSION_ASSIGN_PARAM,
+		INDIVIDUAL_MOD_1_ASSIGN_PARAM,
+		INDIVIDUAL_MOD_2_ASSIGN_PARAM,
+		VOICE_NR_ASSIGN_PARAM,
+		RANDOM_ASSIGN_PARAM,
+
+		ENV1_ASSIGN_PARAM,
+		ENV2_ASSIGN_PARAM,
+		LFO1_UNIPOLAR_ASSIGN_PARAM,
+		LFO1_BIPOLAR_ASSIGN_PARAM,
+		LFO2_UNIPOLAR_ASSIGN_PARAM,
+		LFO2_BIPOLAR_ASSIGN_PARAM,
+		GLOBAL_LFO_ASSIGN_PARAM,
+		DIVERGE_1_ASSIGN_PARAM,
+		DIVERGE_2_ASSIGN_PARAM,
+		DRIFT_1_ASSIGN_PARAM,
+		DRIFT_2_ASSIGN_PARAM,
+
+		// modulatable params
+		ENV1_A_PARAM,
+		ENV1_D_PARAM,
+		ENV1_S_PARAM,
+		ENV1_R_PARAM,
+
+		ENV2_A_PARAM,
+		ENV2_D_PARAM,
+		ENV2_S_PARAM,
+		ENV2_R_PARAM,
+
+		LFO1_FREQ_PARAM,
+		LFO1_AMOUNT_PARAM,
+
+		LFO2_FREQ_PARAM,
+		LFO2_AMOUNT_PARAM,
+
+		GLOBAL_LFO_AMT_PARAM,
+
+		DRIFT_AMOUNT_PARAM,
+
+		INDIVIDUAL_MOD_OUT_1_PARAM,
+		INDIVIDUAL_MOD_OUT_2_PARAM,
+		INDIVIDUAL_MOD_OUT_3_PARAM,
+		INDIVIDUAL_MOD_OUT_4_PARAM,
+		INDIVIDUAL_MOD_OUT_5_PARAM,
+
+		OSC1_TUNE_GLIDE_PARAM,
+		OSC1_TUNE_SEMI_PARAM,
+		OSC1_TUNE_FINE_PARAM,
+		OSC1_SHAPE_PARAM,
+		OSC1_PW_PARAM,
+
+		OSC2_TUNE_GLIDE_PARAM,
+		OSC2_TUNE_SEMI_PARAM,
+		OSC2_TUNE_FINE_PARAM,
+		OSC2_SHAPE_PARAM,
+		OSC2_PW_PARAM,
+
+		OSC_FM_AMOUNT_PARAM,
+
+		FILTER1_CUTOFF_PARAM,
+		FILTER1_RESONANCE_PARAM,
+		FILTER1_PAN_PARAM,
+
+		FILTER2_CUTOFF_PARAM,
+		FILTER2_RESONANCE_PARAM,
+		FILTER2_PAN_PARAM,
+
+		FILTER_SERIAL_PARALLEL_PARAM,
+
+		AMP_VOL_PARAM,
+
+		// mix params
+		OSC1_VOL_PARAM,
+		OSC1_SUB_VOL_PARAM,
+		OSC_RM_VOL_PARAM,
+		OSC_NOISE_VOL_PARAM,
+		OSC2_VOL_PARAM,
+		OSC_EXT_VOL_PARAM,
+
+		// non modulatable params
+		ENV1_VEL_PARAM,
+		ENV2_VEL_PARAM,
+		LFO1_SHAPE_PARAM,
+		LFO1_MODE_PARAM,
+		LFO2_SHAPE_PARAM,
+		LFO2_MODE_PARAM,
+		GLOBAL_LFO_FREQ_PARAM,
+		DRIFT_RATE_PARAM,
+
+		OSC1_TUNE_OCT_PARAM,
+		OSC2_TUNE_OCT_PARAM,
+		OSC_TUNE_GLIDE_FINGERED_PARAM,
+		OSC_MIX_ROUTE_PARAM,
+		OSC_SYNC_PARAM,
+
+		FILTER1_MODE_PARAM,
+		FILTER2_CUTOFF_MODE_PARAM,
+		FILTER2_MODE_PARAM,
+
+		PARAMS_LEN
+	};
+	enum InputId {
+		VOCT_INPUT,
+		GATE_INPUT,
+		VELOCITY_INPUT,
+		AFTERTOUCH_INPUT,
+		PITCH_WHEEL_INPUT,
+		MOD_WHEEL_INPUT,
+		EXPRESSION_INPUT,
+		INDIVIDUAL_MOD_1_INPUT,
+		INDIVIDUAL_MOD_2_INPUT,
+		RETRIGGER_INPUT,
+		EXT_INPUT,
+		INPUTS_LEN
+	};
+	enum OutputId {
+		INDIVIDUAL_MOD_1_OUTPUT,
+		INDIVIDUAL_MOD_2_OUTPUT,
+		INDIVIDUAL_MOD_3_OUTPUT,
+		INDIVIDUAL_MOD_4_OUTPUT,
+		INDIVIDUAL_MOD_5_OUTPUT,
+		OUT_L_OUTPUT,
+		OUT_R_OUTPUT,
+		FILTER1_OUTPUT,
+		FILTER2_OUTPUT,
+		OUTPUTS_LEN
+	};
+	enum LightId {
+		// assign lights
+		VOCT_ASSIGN_LIGHT,
+		GATE_ASSIGN_LIGHT,
+		VELOCITY_ASSIGN_LIGHT,
+		AFTERTOUCH_ASSIGN_LIGHT,
+		PITCH_WHEEL_ASSIGN_LIGHT,
+		MOD_WHEEL_ASSIGN_LIGHT,
+		EXPRESSION_ASSIGN_LIGHT,
+		INDIVIDUAL_MOD_1_ASSIGN_LIGHT,
+		INDIVIDUAL_MOD_2_ASSIGN_LIGHT,
+		VOICE_NR_ASSIGN_LIGHT,
+		RANDOM_ASSIGN_LIGHT,
+
+		ENV1_ASSIGN_LIGHT,
+		ENV2_ASSIGN_LIGHT,
+		LFO1_UNIPOLAR_ASSIGN_LIGHT,
+		LFO1_BIPOLAR_ASSIGN_LIGHT,
+		LFO2_UNIPOLAR_ASSIGN_LIGHT,
+		LFO2_BIPOLAR_ASSIGN_LIGHT,
+		GLOBAL_LFO_ASSIGN_LIGHT,
+		DIVERGE_1_ASSIGN_LIGHT,
+		DIVERGE_2_ASSIGN_LIGHT,
+		DRIFT_1_ASSIGN_LIGHT,
+		DRIFT_2_ASSIGN_LIGHT,
+
+		// mix route light
+		OSC_MIX_ROUTE_LIGHT,
+		OSC_TUNE_GLIDE_FINGERED_LIGHT,
+		OSC_SYNC_LIGHT,
+
+		LIGHTS_LEN
+	};
+
+	//
+	int channels = 1;
+
+	ModuleWidget* widget = nullptr;
+
+	// over/-undersampling, quality
+	int lockQualitySettings = -1;
+	static const size_t maxOversamplingRate = 16;
+	size_t oversamplingRate = 1;
+	size_t newOversamplingRate = 8;
+	size_t sampleRate = 48000;
+
+	HalfBandDecimatorCascade<float_4> decimator;
+	bool iirDecimator = false;
+	bool newIIRDecimator = false;
+
+	// block processing: inputs are recorded and processed every blockSize frames, outputs lag one block behind
+	static const int maxBlockSize = 64;
+	int blockSize = 0; // 0: process every frame immediately
+	int newBlockSize = 0;
+	int blockFrame = 0;
+
+	/** recorded inputs, global modulation and rendered output of one block */
+	struct Block {
+		ProcessArgs args;
+		int frames = 0;
+		int channels = 0;
+		bool extConnected = false;
+		float inputs[maxBlockSize][INPUTS_LEN][16] = {{{0.f}}};
+		bool modTick[maxBlockSize] = {false};
+		float noise1[maxBlockSize] = {0.f};
+		float noise2[maxBlockSize] = {0.f};
+		float globalLfo[maxBlockSize][16] = {{0.f}};
+		float modOutputs[maxBlockSize][INDIVIDUAL_MOD_5_OUTPUT + 1][16] = {{{0.f}}};
+		// L, R, filter 1 and filter 2 in the lanes, per voice group when rendered by workers
+		float_4 bufferLR[4][maxBlockSize * maxOversamplingRate] = {{0.f}};
+	};
+	Block blocks[2];
+	int recordBlock = 0;
+
+	// played back while the next block is recorded
+	bool outputModTick[maxBlockSize] = {false};
+	float outputModOutputs[maxBlockSize][INDIVIDUAL_MOD_5_OUTPUT + 1][16] = {{{0.f}}};
+	float_4 outputLR[maxBlockSize] = {0.f};
+
+	// worker threads render the voice groups of a block while the next one is recorded, this adds another block of latency
+	WorkerPool workerPool; // threads are started and stopped in setWorkerThreads(), not in the audio thread
+	int workerThreads = 0;
+	int newWorkerThreads = 0;
+	Block* workerBlock = nullptr; // block being rendered by the workers
+	bool uiPending = false; // processUi() deferred until the workers are done
+
+	dsp::ClockDivider uiDivider;
+	dsp::ClockDivider modDivider;
+
+	Method filterMethod = Method::RK2;
+	Method newFilterMethod = Method::RK2;
+	bool filterMethodPending = false;
+	IntegratorType filterIntegratorType = IntegratorType::Transistor_tanh;
+	IntegratorType newFilterIntegratorType = IntegratorType::Transistor_tanh;
+	bool filterIntegratorTypePending = false;
+
+	// mod matrix
+	static constexpr size_t nSources = ENV1_A_PARAM + 1; // number of modulation sources, + 1 for base vale
+	static constexpr size_t nMixChannels = 6;
+	static constexpr size_t nDestinations = ENV1_VEL_PARAM - ENV1_A_PARAM + nMixChannels; // number of modulation destinations, additional 6 for mix to filter balance
+
+	size_t activeSourceAssign = 0; // index of active mod source assign button. 0 = base value / no button active
+
+	bool oscMixRouteActive = false; // is the OSC_MIX_ROUTE_PARAM button pressed?
+	float mixLevels[nMixChannels] = {0.};
+	float mixFilterBalances[nMixChannels] = {0.};
+
+	float modMatrix[nDestinations][nSources] = {{0}}; // the mod matrix
+
+	bool mustCalculateDestination[nDestinations] = {false}; // false if all but the first entry of the mod matrix column are 0
+
+	// the non-zero modulations of the mod matrix, without the base values, compiled by compileModMatrix()
+	struct ModTerm {
+		size_t dest;
+		size_t source;
+		float amount;
+	};
+	ModTerm modTerms[nDestinations * nSources]; // additive terms, ordered by destination and source
+	size_t nModTerms = 0;
+	ModTerm ampVolTerms[nSources]; // multiplicative terms of AMP_VOL_PARAM
+	size_t nAmpVolTerms = 0;
+
+	static constexpr float MIN_TIME = 1e-3f;
+	static constexpr float MAX_TIME = 10.f;
+	static constexpr float LAMBDA_BASE = MAX_TIME / MIN_TIME;
+	static constexpr float ATT_TARGET = 1.2f;
+
+	musx::LFOBlock globalLfo;
+	musx::Random globalRandom; // sample & hold of the LFOs
+
+	const float filterMinFreq = 20.f; // min freq [Hz]
+	const float filterMaxFreq = 20480.f; // max freq [Hz] // must be 10 octaves for 1V/Oct cutoff CV scaling to work!
+	const float filterBase = filterMaxFreq/filterMinFreq; // max freq/min freq
+	const float filterLogBase = std::log(filterBase);
+
+	int filter2CutoffMode = 0; // 0: individual, 1: offset, 2: space
+
+	// voice group sleep
+	static constexpr float SLEEP_THRESHOLD = 1.e-4f; // amp gain below -80 dB is silent
+	static constexpr float SLEEP_DELAY = 0.05f; // [s] silence before a voice group stops rendering audio
+	bool voiceSleep = true;
+
+	bool interpolateModulation = true; // ramp the audio-critical destinations between two modulation updates
+
+	/**
+	 * The per voice state and processing, for groups of 4 (SSE) or 8 (AVX2) voices.
+	 * The AVX2 voices are compiled in SynthAvx.cpp and only used when the CPU supports them.
+	 */
+	struct Voices {
+		const int size; // voices per group
+
+		Voices(int size) : size(size) {}
+		virtual ~Voices();
+
+		// float_8 needs 32 byte alignment, which new does not guarantee before C++17
+		static void* operator new(size_t bytes);
+		static void operator delete(void* p);
+
+		virtual void setSampleRate(float sampleRate) = 0;
+		virtual void setOversamplingRate(size_t oversamplingRate, float sampleRate) = 0;
+		virtual void setModSampleRateReduction(size_t arg) = 0;
+		virtual void setDiverge(const float* diverge1, const float* diverge2) = 0;
+		/** noise, random source and drift */
+		virtual void seed(uint64_t s) = 0;
+		virtual void setFilterMethod(Method m) = 0;
+		virtual void setFilterIntegratorType(IntegratorType t) = 0;
+		/** allocate and free the comb filter delay lines, outside the audio thread */
+		virtual void updateDelayLines() = 0;
+		/** non-modulatable parameters */
+		virtual void updateSettings(int channels) = 0;
+		/** reset LFO phases, filters */
+		virtual void reset() = 0;
+
+		/** modulation of one voice group */
+		virtual void processModulation(Block& block, int group, int frame) = 0;
+		/** render frames * oversamplingRate samples of one voice group, and add them to bufferLR */
+		virtual void processAudio(Block& block, int group, int frame, int frames, float_4* bufferLR) = 0;
+	};
+
+	template <typename T>
+	struct TVoices;
+
+	static Voices* createAvxVoices(Synth* synth); // nullptr if not built with AVX2
+
+	int simdWidth = 8; // voices per group, 8 only if the CPU supports AVX2
+	Voices* sseVoices = nullptr;
+	Voices* avxVoices = nullptr;
+	Voices* voices = nullptr; // the voices in use
+
+	// misc
+	bool doRandomize = false;
+	bool doReset = false;
+	bool jsonLoaded = false;
+	int resetModulationsForSourceId = -1;
+	int resetModulationsForDestinationId = -1;
+
+	Synth() {
+		config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
+		configParam(ENV1_VEL_PARAM, 0.f, 1.f, 0.f, "Envelope 1 velocity scaling", " %", 0, 100);
+		configParam(ENV2_VEL_PARAM, 0.f, 1.f, 0.f, "Envelope 2 velocity scaling", " %", 0, 100);
+		configSwitch(LFO1_SHAPE_PARAM, 0, LFOBlock::getShapeLabels().size() - 1, 0, "LFO 1 shape", LFOBlock::getShapeLabels());
+		configSwitch(LFO1_MODE_PARAM, 0, 2, 0, "LFO 1 mode", {"free running", "retrigger", "retrigger, single cycle"});
+		configSwitch(LFO2_SHAPE_PARAM, 0, LFOBlock::getShapeLabels().size() - 1, 0, "LFO 2 shape", LFOBlock::getShapeLabels());
+		configSwitch(LFO2_MODE_PARAM, 0, 2, 0, "LFO 2 mode", {"free running", "retrigger", "retrigger, single cycle"});
+		configParam(GLOBAL_LFO_FREQ_PARAM, -5.f, 5.f, 0.f, "Global LFO frequency", " Hz", 2.f, 2.f);
+		configParam(DRIFT_RATE_PARAM, 0.f, 1.f, 0.5f, "Drift rate", " %", 0, 100.);
+		configParam(OSC1_TUNE_OCT_PARAM, -4, 4, 0, "Oscillator 1 octave");
+		getParamQuantity(OSC1_TUNE_OCT_PARAM)->snapEnabled = true;
+		getParamQuantity(OSC1_TUNE_OCT_PARAM)->smoothEnabled = false;
+		configParam(OSC2_TUNE_OCT_PARAM, -4, 4, 0, "Oscillator 2 octave");
+		getParamQuantity(OSC2_TUNE_OCT_PARAM)->snapEnabled = true;
+		getParamQuantity(OSC2_TUNE_OCT_PARAM)->smoothEnabled = false;
+		configSwitch(OSC_TUNE_GLIDE_FINGERED_PARAM, 0,   1,   0,  "Fingered glide", {"Off", "On"});
+		configSwitch(OSC_SYNC_PARAM, 0,   1,   0,  "Sync", {"Off", "Sync oscillator 2 to oscillator 1"});
+		SwitchQuantity* sq = configSwitch(OSC_MIX_ROUTE_PARAM, 0, 1, 0, "Adjust mixer routing to filter 1 / filter 2", {"off", "active"});
+		sq->ParamQuantity::randomizeEnabled = false;
+		sq->ParamQuantity::resetEnabled = false;
+		configSwitch(FILTER1_MODE_PARAM, 0, FilterBlock::getModeLabels().size() - 1, 8, "Filter 1 mode", FilterBlock::getModeLabels());
+		configSwitch(FILTER2_CUTOFF_MODE_PARAM, 0, 2, 0, "Filter 2 cutoff mode", {"individual", "offset", "space"});
+		configSwitch(FILTER2_MODE_PARAM, 0, FilterBlock::getModeLabels().size() - 1, 8, "Filter 2 mode", FilterBlock::getModeLabels());
+
+		configInput(VOCT_INPUT, "V/Oct");
+		configInput(GATE_INPUT, "Gate");
+		configInput(VELOCITY_INPUT, "Velocity");
+		configInput(AFTERTOUCH_INPUT, "Aftertouch");
+		configInput(PITCH_WHEEL_INPUT, "Pitch wheel");
+		configInput(MOD_WHEEL_INPUT, "Mod wheel");
+		configInput(EXPRESSION_INPUT, "Expression");
+		configInput(INDIVIDUAL_MOD_1_INPUT, "Indvidual modulation 1");
+		configInput(INDIVIDUAL_MOD_2_INPUT, "Indvidual modulation 2");
+		configInput(RETRIGGER_INPUT, "Retrigger");
+		configInput(EXT_INPUT, "External audio");
+		configOutput(INDIVIDUAL_MOD_1_OUTPUT, "Indvidual modulation 1");
+		configOutput(INDIVIDUAL_MOD_2_OUTPUT, "Indvidual modulation 2");
+		configOutput(INDIVIDUAL_MOD_3_OUTPUT, "Indvidual modulation 3");
+		configOutput(INDIVIDUAL_MOD_4_OUTPUT, "Indvidual modulation 4");
+		configOutput(INDIVIDUAL_MOD_5_OUTPUT, "Indvidual modulation 5");
+		configOutput(OUT_L_OUTPUT, "Left/Mono");
+		configOutput(OUT_R_OUTPUT, "Right");
+		configOutput(FILTER1_OUTPUT, "Filter 1");
+		configOutput(FILTER2_OUTPUT, "Filter 2");
+
+		createVoices();
+
+		setOversamplingRate(oversamplingRate);
+
+		configureUi(true);
+
+		uiDivider.setDivision(16);
+		modDivider.setDivision(2);
+
+		configureDrift();
+	}
+
+	~Synth()
+	{
+		finishWorkers();
+		delete sseVoices;
+		delete avxVoices;
+	}
+
+	void createVoices();
+
+	void loadTemplate()
+	{
+		if (!widget || jsonLoaded)
+		{
+			return;
+		}
+
+		Model* m = getModel();
+		if (!m)
+		{
+			return;
+		}
+
+		std::string filename = m->getFactoryPresetDirectory() + "/template.vcvm";
+
+		widget->load(filename);
+	}
+
+	static const std::array<std::string, nSources>& getSourceLabels()
+	{
+		static const std::array<std::string, nSources> sourceLabelMap = {
+			"V/Oct",
+			"gate",
+			"velocity",
+			"aftertouch",
+			"pitch wheel",
+			"mod wheel",
+			"expression pedal",
+			"indvidual modulation 1",
+			"indvidual modulation 2",
+			"voice number",
+			"random",
+
+			"envelope 1",
+			"envelope 2",
+			"LFO 1 (unipolar)",
+			"LFO 1 (bipolar)",
+			"LFO 2 (unipolar)",
+			"LFO 2 (bipolar)",
+			"global LFO (bipolar, monophonic)",
+			"diverge 1",
+			"diverge 2",
+			"drift 1",
+			"drift 2",
+		};
+
+		return sourceLabelMap;
+	}
+
+	static const std::array<std::string, nDestinations>& getDestinationLabels()
+	{
+		static const std::array<std::string, nDestinations> destinationLabelMap = {
+			"envelope 1 Attack",
+			"envelope 1 Decay",
+			"envelope 1 Sustain",
+			"envelope 1 Release",
+
+			"envelope 2 Attack",
+			"envelope 2 Decay",
+			"envelope 2 Sustain",
+			"envelope 2 Release",
+
+			"LFO 1 frequency",
+			"LFO 1 amount",
+
+			"LFO 2 frequency",
+			"LFO 2 amount",
+
+			"global LFO amount",
+
+			"diverge & drift amount",
+
+			"individual modulation 1",
+			"individual modulation 2",
+			"individual modulation 3",
+			"individual modulation 4",
+			"individual modulation 5",
+
+			"oscillator 1 glide",
+			"oscillator 1 semitones",
+			"oscillator 1 fine tune",
+			"oscillator 1 shape",
+			"oscillator 1 triangle phase / pulse width",
+
+			"oscillator 2 glide offset",
+			"oscillator 2 semitones",
+			"oscillator 2 fine tune",
+			"oscillator 2 shape",
+			"oscillator 2 triangle phase / pulse width",
+
+			"oscillator 1 to oscillator 2 FM amount",
+
+			"filter 1 cutoff frequency",
+			"filter 1 resonance",
+			"filter 1 pan",
+
+			"filter 2 cutoff frequency",
+			"filter 2 resonance",
+			"filter 2 pan",
+
+			"filter routing: serial / parallel",
+
+			"amp volume",
+
+			"oscillator 1",
+			"oscillator 1 sub-oscillator",
+			"ring modulator",
+			"noise",
+			"oscillator 2",
+			"external audio input / loopback",
+		};
+
+		return destinationLabelMap;
+	}
+
+	void configureUi(bool initial = false)
+	{
+		const auto& sourceLabels = getSourceLabels();
+		const auto& destinationLabels = getDestinationLabels();
+
+		// bring "Modulates:" labels into correct order
+		std::vector<size_t> destIds;
+		for (size_t i = 0; i < FILTER1_CUTOFF_PARAM - ENV1_A_PARAM; i++)
+		{
+			destIds.push_back(i);
+		}
+		for (size_t i = OSC1_VOL_PARAM - ENV1_A_PARAM; i < OSC1_VOL_PARAM - ENV1_A_PARAM + 2 * nMixChannels; i++)
+		{
+			destIds.push_back(i);
+		}
+		for (size_t i = FILTER1_CUTOFF_PARAM - ENV1_A_PARAM; i < OSC1_VOL_PARAM - ENV1_A_PARAM; i++)
+		{
+			destIds.push_back(i);
+		}
+
+		for (size_t iSource = 0; iSource < sourceLabels.size(); iSource++)
+		{
+			bool isModulating = false;
+			std::string modulatesLabel = "\nModulates:\n";
+			for (size_t iDest : destIds)
+			{
+				if (modMatrix[iDest][iSource + 1] != 0.f)
+				{
+					std::string label = "";
+					if (iDest >= nDestinations - nMixChannels)
+					{
+						label = destinationLabels[iDest - nMixChannels] + " routing (filter 1 / filter 2)";
+					}
+					else if (iDest >= nDestinations - 2 * nMixChannels)
+					{
+						label = destinationLabels[iDest] + " volume";
+					}
+					else
+					{
+						label = destinationLabels[iDest];
+					}
+					label += "\n";
+					label[0] = toupper(label[0]);
+					modulatesLabel += label;
+					isModulating = true;
+				}
+			}
+
+			SwitchQuantity* sw = nullptr;
+			if (initial)
+			{
+				sw = configSwitch(iSource, 0, 1, 0, "Assign " + sourceLabels[iSource], {"off", "active"});
+			}
+			else
+			{
+				sw = dynamic_cast<SwitchQuantity*>(getParamQuantity(iSource));
+			}
+			if (sw)
+			{
+				sw->randomizeEnabled = false;
+				sw->description = "";
+				if (isModulating)
+				{
+					sw->description = modulatesLabel;
+				}
+			}
+
+			if (iSource + 1 == activeSourceAssign)
+			{
+				params[iSource].setValue(1);
+			}
+		}
+
+		for (size_t i = 0; i < nDestinations - 2 * nMixChannels; i++)
+		{
+			// config knobs when source assign is active
+			BipolarColorParamQuantity* param;
+			if (activeSourceAssign)
+			{
+				std::string sourceLabel = sourceLabels[activeSourceAssign - 1];
+
+				switch(ENV1_A_PARAM + i)
+				{
+				case OSC1_TUNE_SEMI_PARAM:
+				case OSC2_TUNE_SEMI_PARAM:
+					switch (activeSourceAssign - 1)
+					{
+					case VOCT_ASSIGN_PARAM:
+						param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, -10.f, 10.f, 5.f,
+								"Assign " + sourceLabel + " to " + destinationLabels[i],
+								" %", 0, 20.);
+						break;
+					case PITCH_WHEEL_ASSIGN_PARAM:
+						param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, -2.f, 2.f, 0.16666666f,
+								"Assign " + sourceLabel + " to " + destinationLabels[i],
+								" semitones", 0, 12.);
+						break;
+					default:
+						param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, -2.f, 2.f, 0.f,
+								"Assign " + sourceLabel + " to " + destinationLabels[i],
+								" %", 0, 50.);
+					}
+					param->snapEnabled = false;
+					param->smoothEnabled = true;
+					break;
+				case FILTER1_CUTOFF_PARAM:
+				case FILTER2_CUTOFF_PARAM:
+					switch (activeSourceAssign - 1)
+					{
+					case VOCT_ASSIGN_PARAM:
+						param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, -2.f, 2.f, 1.f,
+								"Assign " + sourceLabel + " to " + destinationLabels[i],
+								" %", 0, 100.);
+						break;
+					case PITCH_WHEEL_ASSIGN_PARAM:
+						param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, -0.4f, 0.4f, 0.033333333f,
+								"Assign " + sourceLabel + " to " + destinationLabels[i],
+								" semitones", 0, 60.);
+						break;
+					default:
+						param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, -2.f, 2.f, 0.f,
+								"Assign " + sourceLabel + " to " + destinationLabels[i],
+								" %", 0, 50.);
+					}
+					break;
+				default:
+					param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, -1.f, 1.f, 0.f,
+							"Assign " + sourceLabel + " to " + destinationLabels[i],
+							" %", 0, 100.);
+				}
+
+				param->bipolar = true;
+				param->color = SCHEME_BLUE;
+
+				getParam(ENV1_A_PARAM + i).setValue(modMatrix[i][activeSourceAssign]);
+			}
+			// config knobs when source assign is off
+			else
+			{
+				std::string destinationLabel = destinationLabels[i];
+				destinationLabel[0] = toupper(destinationLabel[0]);
+
+				switch(ENV1_A_PARAM + i)
+				{
+				case ENV1_A_PARAM:
+				case ENV1_D_PARAM:
+				case ENV1_R_PARAM:
+				case ENV2_A_PARAM:
+				case ENV2_D_PARAM:
+				case ENV2_R_PARAM:
+					param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, 0.f, 1.f, 0.f,
+							destinationLabel,
+							" ms", LAMBDA_BASE, MIN_TIME * 1000.0);
+					param->bipolar = false;
+					getParam(ENV1_A_PARAM + i).setValue(0.1f * modMatrix[i][activeSourceAssign]);
+					break;
+				case LFO1_FREQ_PARAM:
+				case LFO2_FREQ_PARAM:
+					param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, -7.f, 10.f, 0.f,
+							destinationLabel,
+							" Hz", 2.f, 2.f);
+					param->bipolar = false;
+					getParam(ENV1_A_PARAM + i).setValue(modMatrix[i][activeSourceAssign]);
+					break;
+				case OSC1_TUNE_GLIDE_PARAM:
+					param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, 0.f, 1.f, 0.f,
+							destinationLabel,
+							" ms",
+							getGlideFreq<float_4>(0.f, 40000.f)[0] / getGlideFreq<float_4>(10.f, 40000.f)[0],
+							modDivider.getDivision() / (40000.f * getGlideFreq<float_4>(0.f, 40000.f)[0]) * 183.939720586f);
+					param->bipolar = false;
+					getParam(ENV1_A_PARAM + i).setValue(0.1f * modMatrix[i][activeSourceAssign]);
+					break;
+				case OSC1_TUNE_SEMI_PARAM:
+				case OSC2_TUNE_SEMI_PARAM:
+					param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, -12.f, 12.f, 0.f,
+							destinationLabel,
+							" semitones");
+					param->bipolar = true;
+					param->snapEnabled = true;
+					param->smoothEnabled = false;
+					getParam(ENV1_A_PARAM + i).setValue(12.f / 5.f * modMatrix[i][activeSourceAssign]);
+					break;
+				case OSC1_TUNE_FINE_PARAM:
+				case OSC2_TUNE_FINE_PARAM:
+					param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, -5.f, 5.f, 0.f,
+							destinationLabel,
+							" cents", 0, 20.f);
+					param->bipolar = true;
+					getParam(ENV1_A_PARAM + i).setValue(modMatrix[i][activeSourceAssign]);
+					break;
+				case FILTER1_CUTOFF_PARAM:
+				case FILTER2_CUTOFF_PARAM:
+					if (ENV1_A_PARAM + i == FILTER2_CUTOFF_PARAM && filter2CutoffMode)
+					{
+						param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, 0.f, 1.f, 0.5f,
+								destinationLabel,
+								" %", 0, 200.f, -100.f);
+						param->bipolar = true;
+					}
+					else
+					{
+						param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, 0.f, 1.f, 1.f,
+								destinationLabel,
+								" Hz", filterMaxFreq / filterMinFreq, filterMinFreq);
+						param->bipolar = false;
+					}
+					getParam(ENV1_A_PARAM + i).setValue(0.1f * modMatrix[i][activeSourceAssign]);
+					break;
+				case INDIVIDUAL_MOD_OUT_1_PARAM:
+				case INDIVIDUAL_MOD_OUT_2_PARAM:
+				case INDIVIDUAL_MOD_OUT_3_PARAM:
+				case INDIVIDUAL_MOD_OUT_4_PARAM:
+				case INDIVIDUAL_MOD_OUT_5_PARAM:
+				case OSC2_TUNE_GLIDE_PARAM:
+				case FILTER1_PAN_PARAM:
+				case FILTER2_PAN_PARAM:
+					// bipolar
+					param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, -5.f, 5.f, 0.f,
+							destinationLabel,
+							" %", 0, 20.f);
+					param->bipolar = true;
+					getParam(ENV1_A_PARAM + i).setValue(modMatrix[i][activeSourceAssign]);
+					break;
+				case ENV1_S_PARAM:
+				case ENV2_S_PARAM:
+					param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, 0.f, 10.f, 10.f,
+							destinationLabel,
+							" %", 0, 10.f);
+					param->bipolar = false;
+					getParam(ENV1_A_PARAM + i).setValue(modMatrix[i][activeSourceAssign]);
+					break;
+				case OSC1_SHAPE_PARAM:
+				case OSC1_PW_PARAM:
+				case OSC2_SHAPE_PARAM:
+				case OSC2_PW_PARAM:
+				case AMP_VOL_PARAM:
+					param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, 0.f, 10.f, 5.f,
+							destinationLabel,
+							" %", 0, 10.f);
+					param->bipolar = false;
+					getParam(ENV1_A_PARAM + i).setValue(modMatrix[i][activeSourceAssign]);
+					break;
+				default:
+					// unipolar
+					param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, 0.f, 10.f, 0.f,
+							destinationLabel,
+							" %", 0, 10.f);
+					param->bipolar = false;
+					getParam(ENV1_A_PARAM + i).setValue(modMatrix[i][activeSourceAssign]);
+				}
+
+				param->color = SCHEME_GREEN;
+				param->indicatorColor = SCHEME_BLUE;
+			}
+
+			param->indicator = mustCalculateDestination[i];
+			param->modulatedByTooltips.clear();
+			if (mustCalculateDestination[i])
+			{
+				for (size_t iSource = 1; iSource < nSources; iSource++)
+				{
+					if (modMatrix[i][iSource] != 0.f)
+					{
+						param->modulatedByTooltips.push_back(sourceLabels[iSource - 1]);
+					}
+				}
+			}
+		}
+
+		for (size_t i = nDestinations - 2 * nMixChannels; i < nDestinations - nMixChannels; i++)
+		{
+			if (oscMixRouteActive)
+			{
+				// config mix route knobs when source assign is active
+				BipolarColorParamQuantity* param;
+				if (activeSourceAssign)
+				{
+					std::string sourceLabel = sourceLabels[activeSourceAssign - 1];
+
+					param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, -1.f, 1.f, 0.f,
+							"Assign " + sourceLabel + " to " + destinationLabels[i] + " routing (filter 1 / filter 2)",
+							" %", 0, 100.);
+
+					param->bipolar = true;
+					param->color = SCHEME_PURPLE;
+				}
+				// config mix route knobs when source assign is off
+				else
+				{
+					std::string destinationLabel = destinationLabels[i];
+					destinationLabel[0] = toupper(destinationLabel[0]);
+					param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, -5.f, 5.f, 0.f,
+							destinationLabel + " routing (filter 1 / filter 2)",
+							" %", 0, 20.);
+
+					param->bipolar = true;
+					param->color = SCHEME_RED;
+					param->indicatorColor = SCHEME_PURPLE;
+				}
+
+				param->indicator = mustCalculateDestination[nMixChannels + i];
+				param->modulatedByTooltips.clear();
+				if (mustCalculateDestination[nMixChannels + i])
+				{
+					for (size_t iSource = 1; iSource < nSources; iSource++)
+					{
+						if (modMatrix[nMixChannels + i][iSource] != 0.f)
+						{
+							param->modulatedByTooltips.push_back(sourceLabels[iSource - 1]);
+						}
+					}
+				}
+				getParam(ENV1_A_PARAM + i).setValue(modMatrix[nMixChannels + i][activeSourceAssign]);
+			}
+			else
+			{
+				// config mix volume knobs when source assign is active
+				BipolarColorParamQuantity* param;
+				if (activeSourceAssign)
+				{
+					std::string sourceLabel = sourceLabels[activeSourceAssign - 1];
+
+					param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, -1.f, 1.f, 0.f,
+							"Assign " + sourceLabel + " to " + destinationLabels[i] + " volume",
+							" %", 0, 100.);
+
+					param->bipolar = true;
+					param->color = SCHEME_BLUE;
+				}
+				// config mix volume knobs when source assign is off
+				else
+				{
+					std::string destinationLabel = destinationLabels[i];
+					destinationLabel[0] = toupper(destinationLabel[0]);
+					param = configParamBipolarColorParamQuantity(initial, ENV1_A_PARAM + i, 0.f, 10.f,
+							(i == nDestinations - 2 * nMixChannels) ? 5.f : 0.f,
+							destinationLabel + " volume",
+							" %", 0, 10.);
+
+					param->bipolar = false;
+					param->color = SCHEME_GREEN;
+					param->indicatorColor = SCHEME_BLUE;
+				}
+
+				param->indicator = mustCalculateDestination[i];
+				param->modulatedByTooltips.clear();
+				if (mustCalculateDestination[i])
+				{
+					for (size_t iSource = 1; iSource < nSources; iSource++)
+					{
+						if (modMatrix[i][iSource] != 0.f)
+						{
+							param->modulatedByTooltips.push_back(sourceLabels[iSource - 1]);
+						}
+					}
+				}
+				getParam(ENV1_A_PARAM + i).setValue(modMatrix[i][activeSourceAssign]);
+			}
+		}
+
+		// set lights
+		for (size_t i = 0; i < OSC_MIX_ROUTE_LIGHT; i++)
+		{
+			bool isModulating = false;
+
+			for (size_t iDest = 0; iDest < nDestinations; iDest++)
+			{
+				if (modMatrix[iDest][i + 1] != 0.f)
+				{
+					isModulating = true;
+					break;
+				}
+			}
+
+			if (i == activeSourceAssign - 1)
+			{
+				lights[i].setBrightness(1.f);
+			}
+			else if (isModulating)
+			{
+				lights[i].setBrightness(0.25f);
+			}
+			else
+			{
+				lights[i].setBrightness(0.f);
+			}
+		}
+
+		if (oscMixRouteActive)
+		{
+			lights[OSC_MIX_ROUTE_LIGHT].setBrightness(1.f);
+		}
+		else if (activeSourceAssign == 0)
+		{
+			lights[OSC_MIX_ROUTE_LIGHT].setBrightness(0.f);
+		}
+		else
+		{
+			bool isModulatingMixRoute = false;
+
+			for (size_t iDest = nDestinations - nMixChannels; iDest < nDestinations; iDest++)
+			{
+				if (modMatrix[iDest][activeSourceAssign] != 0.f)
+				{
+					isModulatingMixRoute = true;
+					break;
+				}
+			}
+
+			if (isModulatingMixRoute)
+			{
+				lights[OSC_MIX_ROUTE_LIGHT].setBrightness(0.25f);
+			}
+			else
+			{
+				lights[OSC_MIX_ROUTE_LIGHT].setBrightness(0.f);
+			}
+		}
+
+		// force redraw
+		if (widget)
+		{
+			for (ParamWidget* paramWidget : widget->getParams())
+			{
+				Widget::ChangeEvent e;
+				paramWidget->onChange(e);
+			}
+		}
+	}
+
+	BipolarColorParamQuantity* configParamBipolarColorParamQuantity(bool initial, int paramId, float minValue, float maxValue, float defaultValue, std::string name = "", std::string unit = "", float displayBase = 0.f, float displayMultiplier = 1.f, float displayOffset = 0.f)
+	{
+		// calling configParam when running can lead to SEGFAULTS
+		// call configParam only from Synths's constructor (initial = true)
+		// otherwise just update pq's internal variables
+
+		BipolarColorParamQuantity* pq = nullptr;
+		if (initial)
+		{
+			pq = configParam<BipolarColorParamQuantity>(paramId, minValue, maxValue, defaultValue, name, unit, displayBase, displayMultiplier, displayOffset);
+		}
+		else
+		{
+			pq = dynamic_cast<BipolarColorParamQuantity*>(getParamQuantity(paramId));
+		}
+		if (pq)
+		{
+			pq->minValue = minValue;
+			pq->maxValue = maxValue;
+			pq->defaultValue = defaultValue;
+			pq->name = name;
+			pq->unit = unit;
+			pq->displayBase = displayBase;
+			pq->displayMultiplier = displayMultiplier;
+			pq->displayOffset = displayOffset;
+		}
+		return pq;
+	}
+
+	/**
+	 * Updates mustCalculateDestination and the mod terms from the mod matrix.
+	 * Returns true if a destination got or lost its modulations.
+	 */
+	bool compileModMatrix()
+	{
+		bool changed = false;
+		nModTerms = 0;
+		nAmpVolTerms = 0;
+		for (size_t iDest = 0; iDest < nDestinations; iDest++)
+		{
+			bool oldMustCalculateDestination = mustCalculateDestination[iDest];
+			mustCalculateDestination[iDest] = false;
+			for (size_t iSource = 1; iSource < nSources; iSource++)
+			{
+				if (modMatrix[iDest][iSource] != 0.f)
+				{
+					mustCalculateDestination[iDest] = true;
+					ModTerm term = {iDest, iSource, modMatrix[iDest][iSource]};
+					if (iDest == AMP_VOL_PARAM - ENV1_A_PARAM)
+					{
+						ampVolTerms[nAmpVolTerms++] = term;
+					}
+					else
+					{
+						modTerms[nModTerms++] = term;
+					}
+				}
+			}
+
+			changed |= oldMustCalculateDestination != mustCalculateDestination[iDest];
+		}
+		return changed;
+	}
+
+	void processUi()
+	{
+		#ifdef METAMODULE
+		// no module widget steps on MetaModule, so the comb filter delay lines are allocated here
+		allocateAndFree();
+		#endif
+
+		bool reconfigureUi = false;
+		channels = inputs[VOCT_INPUT].getChannels();
+
+		outputs[INDIVIDUAL_MOD_1_OUTPUT].setChannels(channels);
+		outputs[INDIVIDUAL_MOD_2_OUTPUT].setChannels(channels);
+		outputs[INDIVIDUAL_MOD_3_OUTPUT].setChannels(channels);
+		outputs[INDIVIDUAL_MOD_4_OUTPUT].setChannels(channels);
+		outputs[INDIVIDUAL_MOD_5_OUTPUT].setChannels(channels);
+
+		// update activeSourceAssign and oscMixRouteActive
+		size_t newActiveSourceAssign = 0;
+		for (size_t i = 0; i < ENV1_A_PARAM; i++)
+		{
+			if (params[i].getValue() && i + 1 != activeSourceAssign)
+			{
+				newActiveSourceAssign = i + 1;
+				break;
+			}
+		}
+		if (newActiveSourceAssign == 0 && params[activeSourceAssign - 1].getValue())
+		{
+			newActiveSourceAssign = activeSourceAssign;
+		}
+
+		// switch off other source assign buttons
+		for (size_t i = 0; i < ENV1_A_PARAM; i++)
+		{
+			if (i + 1 != newActiveSourceAssign)
+			{
+				params[i].setValue(0);
+			}
+		}
+
+
+		bool newOscMixRouteActive = params[OSC_MIX_ROUTE_PARAM].getValue() > 0.5f;
+
+		// adapt UI if activeSourceAssign or oscMixRouteActive have changed
+		if (activeSourceAssign != newActiveSourceAssign ||
+				oscMixRouteActive != newOscMixRouteActive ||
+				filter2CutoffMode != (int)getParam(FILTER2_CUTOFF_MODE_PARAM).getValue())
+		{
+			activeSourceAssign = newActiveSourceAssign;
+			oscMixRouteActive = newOscMixRouteActive;
+			filter2CutoffMode = (int)getParam(FILTER2_CUTOFF_MODE_PARAM).getValue();
+			reconfigureUi = true;
+			configureUi();
+		}
+
+		// reset / randomize when no activeSourceAssign
+		if (doReset)
+		{
+			if (activeSourceAssign == 0)
+			{
+				ResetEvent e;
+				Module::onReset(e);
+			}
+		}
+
+		if (doRandomize)
+		{
+			if (activeSourceAssign == 0)
+			{
+				RandomizeEvent e;
+				Module::onRandomize(e);
+			}
+		}
+
+		if (newOversamplingRate != oversamplingRate)
+		{
+			finishWorkers();
+			oversamplingRate = newOversamplingRate;
+			decimator.reset();
+
+			for (Voices* v : {sseVoices, avxVoices})
+			{
+				if (v)
+				{
+					v->setOversamplingRate(oversamplingRate, sampleRate);
+				}
+			}
+		}
+
+		if (newIIRDecimator != iirDecimator)
+		{
+			finishWorkers();
+			iirDecimator = newIIRDecimator;
+			decimator.setIIR(iirDecimator);
+		}
+
+		// switching the method or integrator type replaces the filters of the voices, which the workers may be using
+		if (filterMethodPending)
+		{
+			finishWorkers();
+			filterMethodPending = false;
+			filterMethod = newFilterMethod;
+			for (Voices* v : {sseVoices, avxVoices})
+			{
+				if (v)
+				{
+					v->setFilterMethod(filterMethod);
+				}
+			}
+		}
+
+		if (filterIntegratorTypePending)
+		{
+			finishWorkers();
+			filterIntegratorTypePending = false;
+			filterIntegratorType = newFilterIntegratorType;
+			for (Voices* v : {sseVoices, avxVoices})
+			{
+				if (v)
+				{
+					v->setFilterIntegratorType(filterIntegratorType);
+				}
+			}
+		}
+
+		selectVoices();
+
+		if (newBlockSize != blockSize || newWorkerThreads != workerThreads)
+		{
+			// drop the block in progress
+			finishWorkers();
+			workerThreads = newWorkerThreads;
+			blockSize = newBlockSize;
+			blockFrame = 0;
+			std::memset(outputModTick, 0, sizeof(outputModTick));
+			std::memset(outputLR, 0, sizeof(outputLR));
+		}
+
+		// update mod matrix elements
+		for (size_t i = 0; i < nDestinations - 2 * nMixChannels; i++)
+		{
+			if (activeSourceAssign == 0)
+			{
+				switch (ENV1_A_PARAM + i)
+				{
+				case ENV1_A_PARAM:
+				case ENV1_D_PARAM:
+				case ENV1_R_PARAM:
+				case ENV2_A_PARAM:
+				case ENV2_D_PARAM:
+				case ENV2_R_PARAM:
+				case OSC1_TUNE_GLIDE_PARAM:
+				case FILTER1_CUTOFF_PARAM:
+				case FILTER2_CUTOFF_PARAM:
+					modMatrix[i][activeSourceAssign] = getParam(ENV1_A_PARAM + i).getValue() * 10.f;
+					break;
+				case OSC1_TUNE_SEMI_PARAM:
+				case OSC2_TUNE_SEMI_PARAM:
+					modMatrix[i][activeSourceAssign] = getParam(ENV1_A_PARAM + i).getValue() * 5.f / 12.f;
+					break;
+				default:
+					modMatrix[i][activeSourceAssign] = getParam(ENV1_A_PARAM + i).getValue();
+				}
+			}
+			else
+			{
+				modMatrix[i][activeSourceAssign] = getParam(ENV1_A_PARAM + i).getValue();
+			}
+		}
+
+		if (oscMixRouteActive)
+		{
+			for (size_t i = nDestinations - 2 * nMixChannels; i < nDestinations - nMixChannels; i++)
+			{
+				modMatrix[i + nMixChannels][activeSourceAssign] = getParam(ENV1_A_PARAM + i).getValue();
+			}
+		}
+		else
+		{
+			for (size_t i = nDestinations - 2 * nMixChannels; i < nDestinations - nMixChannels; i++)
+			{
+				modMatrix[i][activeSourceAssign] = getParam(ENV1_A_PARAM + i).getValue();
+			}
+		}
+
+
+		// handle resets from assign button and knob context menu
+		if (resetModulationsForDestinationId != -1)
+		{
+			for (size_t iSource = 1; iSource < nSources; iSource++)
+			{
+				modMatrix[resetModulationsForDestinationId][iSource] = 0.f;
+			}
+			reconfigureUi = true;
+			resetModulationsForDestinationId = -1;
+		}
+
+		if (resetModulationsForSourceId != -1)
+		{
+			for (size_t iDest = 0; iDest < nDestinations; iDest++)
+			{
+				modMatrix[iDest][resetModulationsForSourceId] = 0.f;
+			}
+			reconfigureUi = true;
+			resetModulationsForSourceId = -1;
+		}
+
+		// module reset/randomize when activeSourceAssign is active
+		if (doReset)
+		{
+			doReset = false;
+			reconfigureUi = true;
+
+			if (activeSourceAssign > 0)
+			{
+				// reset only modulation assignments when activeSourceAssign
+				for (size_t iDest = 0; iDest < nDestinations; iDest++)
+				{
+					modMatrix[iDest][activeSourceAssign] = 0.f;
+				}
+			}
+		}
+
+		if (doRandomize)
+		{
+			doRandomize = false;
+			reconfigureUi = true;
+
+			if (activeSourceAssign > 0)
+			{
+				// randomize only modulatable params when activeSourceAssign
+				for (size_t iDest = 0; iDest < nDestinations; iDest++)
+				{
+					modMatrix[iDest][activeSourceAssign] = 2.f * rack::random::uniform() - 1.f;
+				}
+			}
+		}
+
+		reconfigureUi |= compileModMatrix();
+
+		if (reconfigureUi)
+		{
+			// configure UI again to set tooltips
+			configureUi();
+		}
+
+
+		// set non-modulatable parameters
+		voices->updateSettings(channels);
+		globalLfo.setFrequencyVOct(getParam(GLOBAL_LFO_FREQ_PARAM).getValue());
+
+
+		// lights
+		lights[OSC_TUNE_GLIDE_FINGERED_LIGHT].setBrightness(getParam(OSC_TUNE_GLIDE_FINGERED_PARAM).getValue());
+		lights[OSC_SYNC_LIGHT].setBrightness(getParam(OSC_SYNC_PARAM).getValue());
+	}
+
+	void onAdd(const AddEvent& e) override
+	{
+		Module::onAdd(e);
+		// the id is known now, so the noise and random source are the same when the patch is loaded again
+		globalRandom.seed(getId());
+		for (Voices* v : {sseVoices, avxVoices})
+		{
+			if (v)
+			{
+				v->seed(getId());
+			}
+		}
+	}
+
+	void onSampleRateChange(const SampleRateChangeEvent& e) override {
+		finishWorkers();
+		sampleRate = e.sampleRate;
+		for (Voices* v : {sseVoices, avxVoices})
+		{
+			if (v)
+			{
+				v->setSampleRate(sampleRate);
+			}
+		}
+		globalLfo.setSampleRate(sampleRate);
+		setOversamplingRate(oversamplingRate);
+	}
+
+	void allocateAndFree() override
+	{
+		for (Voices* v : {sseVoices, avxVoices})
+		{
+			if (v)
+			{
+				v->updateDelayLines();
+			}
+		}
+	}
+
+	void setOversamplingRate(size_t arg)
+	{
+		newOversamplingRate = arg;
+		// set later in audio thread
+	}
+
+	void setIIRDecimator(bool arg)
+	{
+		newIIRDecimator = arg;
+		// set later in audio thread
+	}
+
+	void setBlockSize(int arg)
+	{
+		newBlockSize = clamp(arg, 0, maxBlockSize);
+		// set later in audio thread
+	}
+
+	void setWorkerThreads(int arg)
+	{
+		#ifdef METAMODULE
+		arg = 0;
+		#endif
+		newWorkerThreads = clamp(arg, 0, 4);
+		// the audio thread runs the jobs the workers do not pick up, so the threads can change while it submits
+		workerPool.setThreads(newWorkerThreads);
+		// used later in audio thread
+	}
+
+	void setSimdWidth(int arg)
+	{
+		simdWidth = arg == 4 ? 4 : 8;
+		// set later in audio thread
+	}
+
+	void selectVoices()
+	{
+		Voices* newVoices = (simdWidth == 8 && avxVoices) ? avxVoices : sseVoices;
+		if (newVoices != voices)
+		{
+			finishWorkers();
+			voices = newVoices;
+		}
+	}
+
+	void setModSampleRateReduction(size_t arg)
+	{
+		modDivider.setDivision(arg);
+
+		for (Voices* v : {sseVoices, avxVoices})
+		{
+			if (v)
+			{
+				v->setModSampleRateReduction(arg);
+			}
+		}
+		globalLfo.setSampleRateReduction(arg);
+	}
+
+	void configureDrift()
+	{
+		if (this->getId())
+		{
+			// use id to get diverge which is unique for every module instance, but stays the same when the patch is loaded again
+			rack::random::local().seed(this->getId(), 1103554439654531);
+		}
+
+		// drawn in groups of 4, so every voice keeps its diverge whatever the vector width
+		float diverge1[16];
+		float diverge2[16];
+		for (int c = 0; c < 16; c += 4)
+		{
+			for (int i = c; i < c + 4; i++)
+			{
+				diverge1[i] = 10.f * (rack::random::get<float>() - 0.5f); // +-5V
+			}
+			for (int i = c; i < c + 4; i++)
+			{
+				diverge2[i] = 10.f * (rack::random::get<float>() - 0.5f);
+			}
+		}
+
+		for (Voices* v : {sseVoices, avxVoices})
+		{
+			if (v)
+			{
+				v->setDiverge(diverge1, diverge2);
+			}
+		}
+	}
+
+	void setFilterMethod(Method m)
+	{
+		newFilterMethod = m;
+		filterMethodPending = true;
+		// set later in audio thread
+	}
+
+	void setFilterIntegratorType(IntegratorType t)
+	{
+		newFilterIntegratorType = t;
+		filterIntegratorTypePending = true;
+		// set later in audio thread
+	}
+
+	void onReset(const ResetEvent& e) override
+	{
+		// reset later in audio thread instead of here in UI thread
+		doReset = true;
+	}
+
+	void onRandomize(const RandomizeEvent& e) override
+	{
+		// randomize later in audio thread instead of here in UI thread
+		doRandomize = true;
+	}
+
+	void appendToParamContextMenu(ParamWidget* param, ui::Menu* menu) override
+	{
+		menu->addChild(new MenuSeparator);
+		menu->addChild(createMenuItem(
+				"Clear modulations for this destination",
+				"",
+				[=]() {resetModulationsForDestination(param->paramId);}));
+	}
+
+	void resetModulationsForDestination(int paramId)
+	{
+		if (paramId == -1)
+		{
+			return;
+		}
+
+		size_t iDest = paramId - DRIFT_2_ASSIGN_PARAM - 1;
+		if (oscMixRouteActive)
+		{
+			iDest += nMixChannels;
+		}
+
+		// handle reset later in audio thread instead of here in UI thread
+		resetModulationsForDestinationId = iDest;
+	}
+
+	void appendToSwitchContextMenu(ParamWidget* param, ui::Menu* menu) override
+	{
+		menu->addChild(new MenuSeparator);
+		menu->addChild(createMenuItem(
+				"Clear modulations for this source",
+				"",
+				[=]() {resetModulationsForSource(param->paramId);}));
+	}
+
+	void resetModulationsForSource(int paramId)
+	{
+		if (paramId == -1)
+		{
+			return;
+		}
+
+		// handle reset later in audio thread instead of here in UI thread
+		resetModulationsForSourceId = paramId + 1;
+	}
+
+	void process(const ProcessArgs& args) override {
+
+		if (uiDivider.process())
+		{
+			if (workerBlock)
+			{
+				// the voices belong to the workers until their block is collected
+				uiPending = true;
+			}
+			else
+			{
+				processUi();
+			}
+		}
+
+		if (!channels)
+		{
+			// no input connected
+			finishWorkers();
+			outputs[OUT_L_OUTPUT].setVoltage(0.f);
+			outputs[OUT_R_OUTPUT].setVoltage(0.f);
+			outputs[FILTER1_OUTPUT].setVoltage(0.f);
+			outputs[FILTER2_OUTPUT].setVoltage(0.f);
+			return;
+		}
+
+		readInputs(blockFrame);
+
+		if (blockSize == 0)
+		{
+			// no latency, process every frame right away
+			processBlock(args, 1);
+			writeOutputs(0);
+			return;
+		}
+
+		// play back the previous block while recording the inputs for the next one
+		writeOutputs(blockFrame);
+		if (++blockFrame == blockSize)
+		{
+			processBlock(args, blockSize);
+			blockFrame = 0;
+		}
+	}
+
+	void readInputs(int frame)
+	{
+		Block& block = blocks[recordBlock];
+		for (int iInput = 0; iInput < INPUTS_LEN; iInput++)
+		{
+			for (int c = 0; c < channels; c += 4)
+			{
+				inputs[iInput].getPolyVoltageSimd<float_4>(c).store(&block.inputs[frame][iInput][c]);
+			}
+		}
+	}
+
+	void writeOutputs(int frame)
+	{
+		if (outputModTick[frame])
+		{
+			for (int iOutput = INDIVIDUAL_MOD_1_OUTPUT; iOutput <= INDIVIDUAL_MOD_5_OUTPUT; iOutput++)
+			{
+				for (int c = 0; c < channels; c += 4)
+				{
+					outputs[iOutput].setVoltageSimd(float_4::load(&outputModOutputs[frame][iOutput][c]), c);
+				}
+			}
+		}
+
+		outputs[OUT_L_OUTPUT].setVoltage(outputLR[frame][0]);
+		outputs[OUT_R_OUTPUT].setVoltage(outputLR[frame][1]);
+		outputs[FILTER1_OUTPUT].setVoltage(outputLR[frame][2]);
+		outputs[FILTER2_OUTPUT].setVoltage(outputLR[frame][3]);
+	}
+
+	/** process the recorded inputs, the audio is rendered in one go between two modulation updates */
+	void processBlock(const ProcessArgs& args, int frames)
+	{
+		Block& block = blocks[recordBlock];
+		block.args = args;
+		block.frames = frames;
+		block.channels = channels;
+		block.extConnected = inputs[EXT_INPUT].isConnected();
+
+		// global modulation, the voice groups only read it
+		for (int frame = 0; frame < frames; frame++)
+		{
+			block.modTick[frame] = modDivider.process();
+			if (block.modTick[frame])
+			{
+				processGlobalModulation(block, frame);
+			}
+		}
+
+		// collect the previous block from the workers, and catch up on the settings
+		if (workerBlock)
+		{
+			finishWorkers();
+			if (uiPending)
+			{
+				uiPending = false;
+				processUi();
+			}
+		}
+
+		if (blockSize > 0 && workerThreads > 0)
+		{
+			// hand this block over to the workers
+			workerBlock = &block;
+			workerPool.submit(processGroupJob, this, (channels + voices->size - 1) / voices->size);
+			recordBlock ^= 1;
+			return;
+		}
+
+		std::memset(block.bufferLR[0], 0, frames * oversamplingRate * sizeof(float_4));
+		int start = 0;
+		for (int frame = 0; frame < frames; frame++)
+		{
+			if (block.modTick[frame])
+			{
+				if (frame > start)
+				{
+					processAudio(block, start, frame - start, block.bufferLR[0]);
+				}
+				for (int group = 0; group * voices->size < channels; group++)
+				{
+					voices->processModulation(block, group, frame);
+				}
+				start = frame;
+			}
+		}
+		processAudio(block, start, frames - start, block.bufferLR[0]);
+
+		finishBlock(block, 1);
+	}
+
+	/** worker job: modulation and audio of one voice group for a whole block */
+	static void processGroupJob(void* context, int group)
+	{
+		Synth* synth = static_cast<Synth*>(context);
+		synth->processGroup(*synth->workerBlock, group);
+	}
+
+	void processGroup(Block& block, int group)
+	{
+		float_4* bufferLR = block.bufferLR[group];
+		std::memset(bufferLR, 0, block.frames * oversamplingRate * sizeof(float_4));
+		int start = 0;
+		for (int frame = 0; frame < block.frames; frame++)
+		{
+			if (block.modTick[frame])
+			{
+				if (frame > start)
+				{
+					voices->processAudio(block, group, start, frame - start, bufferLR);
+				}
+				voices->processModulation(block, group, frame);
+				start = frame;
+			}
+		}
+		voices->processAudio(block, group, start, block.frames - start, bufferLR);
+	}
+
+	/** wait for the workers and collect the block they have rendered */
+	void finishWorkers()
+	{
+		if (workerBlock)
+		{
+			workerPool.wait();
+			finishBlock(*workerBlock, (workerBlock->channels + voices->size - 1) / voices->size);
+			workerBlock = nullptr;
+		}
+	}
+
+	/** sum the voice group buffers, downsample, and queue the block for playback */
+	void finishBlock(Block& block, int groups)
+	{
+		float_4* bufferLR = block.bufferLR[0];
+		int length = block.frames * oversamplingRate;
+		for (int group = 1; group < groups; group++)
+		{
+			for (int iSample = 0; iSample < length; iSample++)
+			{
+				bufferLR[iSample] += block.bufferLR[group][iSample];
+			}
+		}
+
+		// downsampling
+		decimator.processBlock(bufferLR, outputLR, oversamplingRate, block.frames);
+
+		for (int frame = 0; frame < block.frames; frame++)
+		{
+			outputModTick[frame] = block.modTick[frame];
+			if (outputModTick[frame])
+			{
+				std::memcpy(outputModOutputs[frame], block.modOutputs[frame], sizeof(outputModOutputs[frame]));
+			}
+		}
+	}
+
+	void processGlobalModulation(Block& block, int frame)
+	{
+		float_4 noise = globalRandom.uniform();
+		block.noise1[frame] = noise[0];
+		block.noise2[frame] = noise[1];
+		globalLfo.process();
+		for (int c = 0; c < 16; c += 4)
+		{
+			globalLfo.getBipolar().store(&block.globalLfo[frame][c]);
+		}
+	}
+
+	void processAudio(Block& block, int frame, int frames, float_4* bufferLR)
+	{
+		for (int group = 0; group * voices->size < block.channels; group++)
+		{
+			voices->processAudio(block, group, frame, frames, bufferLR);
+		}
+	}
+
+	json_t* dataToJson() override {
+		json_t* rootJ = json_object();
+		json_t* entryJ;
+
+		json_t* modMatrixJ = json_array();
+		for (size_t iDest = 0; iDest < nDestinations; iDest++)
+		{
+			for (size_t iSource = 0; iSource < nSources; iSource++)
+			{
+				entryJ = json_real(modMatrix[iDest][iSource]);
+				json_array_insert_new(modMatrixJ, iDest * nSources + iSource, entryJ);
+			}
+		}
+		json_object_set_new(rootJ, "modMatrix", modMatrixJ);
+
+		json_t* mixLevelsJ = json_array();
+		for (size_t i = 0; i < nMixChannels; i++)
+		{
+			json_t* entryJ = json_real(mixLevels[i]);
+			json_array_insert_new(mixLevelsJ, i, entryJ);
+		}
+		json_object_set_new(rootJ, "mixLevels", mixLevelsJ);
+
+		json_t* mixFilterBalancesJ = json_array();
+		for (size_t i = 0; i < nMixChannels; i++)
+		{
+			json_t* entryJ = json_real(mixFilterBalances[i]);
+			json_array_insert_new(mixFilterBalancesJ, i, entryJ);
+		}
+		json_object_set_new(rootJ, "mixFilterBalances", mixFilterBalancesJ);
+
+		std::vector<std::string> labels = FilterBlock::getModeLabels();
+		json_object_set_new(rootJ, "filter1Mode", json_string(labels[params[FILTER1_MODE_PARAM].getValue()].c_str()));
+		json_object_set_new(rootJ, "filter2Mode", json_string(labels[params[FILTER2_MODE_PARAM].getValue()].c_str()));
+
+		json_object_set_new(rootJ, "oversamplingRate", json_integer(oversamplingRate));
+		json_object_set_new(rootJ, "iirDecimator", json_boolean(newIIRDecimator));
+		json_object_set_new(rootJ, "modSampleRateReduction", json_integer(modDivider.getDivision()));
+		json_object_set_new(rootJ, "uiSampleRateReduction", json_integer(uiDivider.getDivision()));
+		json_object_set_new(rootJ, "filterMethod", json_integer((int)newFilterMethod));
+		json_object_set_new(rootJ, "blockSize", json_integer(newBlockSize));
+		json_object_set_new(rootJ, "workerThreads", json_integer(newWorkerThreads));
+		json_object_set_new(rootJ, "simdWidth", json_integer(simdWidth));
+		json_object_set_new(rootJ, "lockQualitySettings", json_boolean(lockQualitySettings));
+
+		json_object_set_new(rootJ, "filterIntegratorType", json_integer((int)newFilterIntegratorType));
+		json_object_set_new(rootJ, "voiceSleep", json_boolean(voiceSleep));
+		json_object_set_new(rootJ, "interpolateModulation", json_boolean(interpolateModulation));
+
+		return rootJ;
+	}
+
+	void dataFromJson(json_t* rootJ) override {
+		finishWorkers();
+		jsonLoaded = true;
+
+		json_t* entryJ;
+
+		json_t* modMatrixJ = json_object_get(rootJ, "modMatrix");
+		if (modMatrixJ)
+		{
+			for (size_t iDest = 0; iDest < nDestinations; iDest++)
+			{
+				for (size_t iSource = 0; iSource < nSources; iSource++)
+				{
+					entryJ = json_array_get(modMatrixJ, iDest * nSources + iSource);
+					if (entryJ)
+					{
+						modMatrix[iDest][iSource] = json_real_value(entryJ);
+					}
+				}
+			}
+		}
+
+		json_t* mixLevelsJ = json_object_get(rootJ, "mixLevels");
+		if (mixLevelsJ)
+		{
+			for (size_t i = 0; i < nMixChannels; i++)
+			{
+				json_t* entryJ = json_array_get(mixLevelsJ, i);
+				if (entryJ)
+				{
+					mixLevels[i] = json_real_value(entryJ);
+				}
+			}
+		}
+
+		json_t* mixFilterBalancesJ = json_object_get(rootJ, "mixFilterBalances");
+		if (mixFilterBalancesJ)
+		{
+			for (size_t i = 0; i < nMixChannels; i++)
+			{
+				json_t* entryJ = json_array_get(mixFilterBalancesJ, i);
+				if (entryJ)
+				{
+					mixFilterBalances[i] = json_real_value(entryJ);
+				}
+			}
+		}
+
+		// read filter mode from label string, allows adding filter modes in future releases without breaking patches
+		std::vector<std::string> labels = FilterBlock::getModeLabels();
+		json_t* filter1ModeJ = json_object_get(rootJ, "filter1Mode");
+		if (filter1ModeJ)
+		{
+			auto it = std::find(labels.begin(), labels.end(), json_string_value(filter1ModeJ));
+			if (it != labels.end())
+			{
+				params[FILTER1_MODE_PARAM].setValue(std::distance(labels.begin(), it));
+			}
+		}
+		json_t* filter2ModeJ = json_object_get(rootJ, "filter2Mode");
+		if (filter2ModeJ)
+		{
+			auto it = std::find(labels.begin(), labels.end(), json_string_value(filter2ModeJ));
+			if (it != labels.end())
+			{
+				params[FILTER2_MODE_PARAM].setValue(std::distance(labels.begin(), it));
+			}
+		}
+
+		if (lockQualitySettings != 1)
+		{
+			json_t* oversamplingRateJ = json_object_get(rootJ, "oversamplingRate");
+			if (oversamplingRateJ)
+			{
+				setOversamplingRate(json_integer_value(oversamplingRateJ));
+			}
+
+			json_t* iirDecimatorJ = json_object_get(rootJ, "iirDecimator");
+			if (iirDecimatorJ)
+			{
+				setIIRDecimator(json_boolean_value(iirDecimatorJ));
+			}
+
+			json_t* modSampleRateReductionJ = json_object_get(rootJ, "modSampleRateReduction");
+			if (modSampleRateReductionJ)
+			{
+				setModSampleRateReduction(json_integer_value(modSampleRateReductionJ));
+			}
+
+			json_t* uiSampleRateReductionJ = json_object_get(rootJ, "uiSampleRateReduction");
+			if (uiSampleRateReductionJ)
+			{
+				uiDivider.setDivision(json_integer_value(uiSampleRateReductionJ));
+			}
+
+			json_t* filterMethodJ = json_object_get(rootJ, "filterMethod");
+			if (filterMethodJ)
+			{
+				setFilterMethod((Method)json_integer_value(filterMethodJ));
+			}
+
+			json_t* blockSizeJ = json_object_get(rootJ, "blockSize");
+			if (blockSizeJ)
+			{
+				setBlockSize(json_integer_value(blockSizeJ));
+			}
+
+			json_t* workerThreadsJ = json_object_get(rootJ, "workerThreads");
+			if (workerThreadsJ)
+			{
+				setWorkerThreads(json_integer_value(workerThreadsJ));
+			}
+
+			json_t* simdWidthJ = json_object_get(rootJ, "simdWidth");
+			if (simdWidthJ)
+			{
+				setSimdWidth(json_integer_value(simdWidthJ));
+			}
+		}
+
+		if (lockQualitySettings == -1)
+		{
+			// load lockQualitySettings only on initial load
+			json_t* lockQualitySettingsJ = json_object_get(rootJ, "lockQualitySettings");
+			if (lockQualitySettingsJ)
+			{
+				lockQualitySettings = json_boolean_value(lockQualitySettingsJ);
+			}
+		}
+
+		json_t* filterIntegratorTypeJ = json_object_get(rootJ, "filterIntegratorType");
+		if (filterIntegratorTypeJ)
+		{
+			setFilterIntegratorType((IntegratorType)json_integer_value(filterIntegratorTypeJ));
+		}
+
+		json_t* voiceSleepJ = json_object_get(rootJ, "voiceSleep");
+		if (voiceSleepJ)
+		{
+			voiceSleep = json_boolean_value(voiceSleepJ);
+		}
+
+		json_t* interpolateModulationJ = json_object_get(rootJ, "interpolateModulation");
+		if (interpolateModulationJ)
+		{
+			interpolateModulation = json_boolean_value(interpolateModulationJ);
+		}
+
+		compileModMatrix();
+
+		// diverge
+		configureDrift();
+
+		selectVoices();
+
+		configureUi();
+
+		// reset LFO phases, filters
+		globalLfo.resetPhases();
+		for (Voices* v : {sseVoices, avxVoices})
+		{
+			if (v)
+			{
+				v->reset();
+			}
+		}
+	}
+
+	template <typename T>
+	T getGlideFreq(T glideValue, float sampleRate)
+	{
+		const float glideScale = 1.5f;
+		T glideFreq = clamp(10.f - glideValue, 0.f, 10.f); // 10..0
+		glideFreq = dsp::exp2_taylor5(glideScale * glideFreq) / dsp::exp2_taylor5(glideScale * 10.f); // 1..0
+		glideFreq *= modDivider.getDivision() / sampleRate * 1000.f;
+		return glideFreq;
+	}
+};
+
+/**
+ * T vector type, float_4 or float_8
+ */
+template <typename T>
+struct Synth::TVoices : Synth::Voices {
+	typedef Synth::Block Block;
+
+	static constexpr int groups = 16 / T::size;
+
+	Synth* synth;
+
+	T modMatrixInputs[nSources][groups] = {{0.f}};
+	T modMatrixOutputs[nDestinations][groups] = {{0.f}};
+
+	// modulation blocks
+	T lastGate[groups] = {0.f};
+	T lastTrigger[groups] = {0.f};
+
+	TADSRBlock<T> env1[groups] = {TADSRBlock<T>(MIN_TIME, MAX_TIME, ATT_TARGET)};
+	TADSRBlock<T> env2[groups] = {TADSRBlock<T>(MIN_TIME, MAX_TIME, ATT_TARGET)};
+
+	TLFOBlock<T> lfo1[groups];
+	TLFOBlock<T> lfo2[groups];
+	TDriftBlock<T> drift1[groups];
+	TDriftBlock<T> drift2[groups];
+
+	TRandom<T> rng[groups]; // random source and noise, a generator per group, so the workers can render them in parallel
+
+	// audio blocks
+	TOnePoleZDF<T> glide1[groups];
+	TOnePoleZDF<T> glide2[groups];
+	OscillatorsBlock<maxOversamplingRate, T> oscillators[groups];
+
+	T noiseVol1[groups] = {0.f};
+	T noiseVol2[groups] = {0.f};
+
+	// the audio-critical destinations, ramped from one modulation update to the next
+	enum RampId {
+		OSC1_FREQ_RAMP,
+		OSC1_SHAPE_RAMP,
+		OSC1_PW_RAMP,
+		OSC1_VOL_RAMP,
+		OSC1_PAN_RAMP,
+		OSC1_SUB_VOL_RAMP,
+		OSC1_SUB_PAN_RAMP,
+		OSC2_FREQ_RAMP,
+		OSC2_SHAPE_RAMP,
+		OSC2_PW_RAMP,
+		OSC2_VOL_RAMP,
+		OSC2_PAN_RAMP,
+		FM_AMOUNT_RAMP,
+		RM_VOL_RAMP,
+		RM_PAN_RAMP,
+		NOISE_VOL_1_RAMP,
+		NOISE_VOL_2_RAMP,
+		EXT_VOL_1_RAMP,
+		EXT_VOL_2_RAMP,
+		FILTER1_CUTOFF_RAMP, // [V], before the exponential
+		FILTER1_RESONANCE_RAMP,
+		FILTER2_CUTOFF_RAMP,
+		FILTER2_RESONANCE_RAMP,
+		FILTER1_PAN_RAMP,
+		FILTER2_PAN_RAMP,
+		AMP_VOL_RAMP,
+		RAMPS_LEN
+	};
+	T rampValue[RAMPS_LEN][groups] = {{0.f}};
+	T rampTarget[RAMPS_LEN][groups] = {{0.f}};
+	T rampStep[RAMPS_LEN][groups] = {{0.f}};
+	int rampFrames[groups] = {0}; // frames until the ramps reach their targets
+	// the oscillator and filter settings follow the ramps in steps of this many frames, the levels and pans sample by sample
+	static const int rampChunkFrames = 8;
+
+	T lastExtIn[groups] = {0.f};
+	T extVol1[groups] = {0.f};
+	T extVol2[groups] = {0.f};
+
+	TOnePole<T> dcBlocker1[groups];
+	AliasReductionFilter<T> aliasFilter1[groups];
+	TFilterBlock<T> filter1[groups];
+	AntialiasedCheapSaturator<T> saturator1[groups];
+	T delayBuffer1[groups][maxOversamplingRate] = {{0.f}};
+	T groupBuffer1[groups][(maxBlockSize + 1) * maxOversamplingRate] = {{0.f}};
+
+	T delayBuffer2[groups][maxOversamplingRate] = {{0.f}};
+	T groupBuffer2[groups][(maxBlockSize + 1) * maxOversamplingRate] = {{0.f}};
+	TOnePole<T> dcBlocker2[groups];
+	AliasReductionFilter<T> aliasFilter2[groups];
+	TFilterBlock<T> filter2[groups];
+	AntialiasedCheapSaturator<T> saturator2[groups];
+
+	// voice group sleep
+	bool groupSleeping[groups] = {false};
+	float groupSilentTime[groups] = {0.f};
+
+	TVoices(Synth* synth) : Voices(T::size), synth(synth)
+	{
+		for (int g = 0; g < groups; g++)
+		{
+			drift1[g].setDivergeAmount(0.f);
+			drift1[g].setDriftAmount(1.f);
+			drift2[g].setDivergeAmount(0.f);
+			drift2[g].setDriftAmount(1.f);
+		}
+	}
+
+	void setSampleRate(float sampleRate) override
+	{
+		for (int g = 0; g < groups; g++)
+		{
+			oscillators[g].setSampleRate(sampleRate);
+
+			lfo1[g].setSampleRate(sampleRate);
+			lfo2[g].setSampleRate(sampleRate);
+
+			drift1[g].setSampleRate(sampleRate);
+			drift1[g].setFilterFrequencyV(synth->getParam(DRIFT_RATE_PARAM).getValue());
+			drift2[g].setSampleRate(sampleRate);
+			drift2[g].setFilterFrequencyV(synth->getParam(DRIFT_RATE_PARAM).getValue());
+
+			filter1[g].setSampleTime(1.f / (sampleRate * synth->oversamplingRate));
+			filter2[g].setSampleTime(1.f / (sampleRate * synth->oversamplingRate));
+		}
+	}
+
+	void setOversamplingRate(size_t oversamplingRate, float sampleRate) override
+	{
+		for (int g = 0; g < groups; g++)
+		{
+			oscillators[g].setOversamplingRate(oversamplingRate);
+
+			dcBlocker1[g].setCutoffFreq(20.f/sampleRate/oversamplingRate);
+			aliasFilter1[g].setCutoffFreq(18000.f/sampleRate/oversamplingRate);
+
+			dcBlocker2[g].setCutoffFreq(20.f/sampleRate/oversamplingRate);
+			aliasFilter2[g].setCutoffFreq(18000.f/sampleRate/oversamplingRate);
+
+			filter1[g].setSampleTime(1.f / (sampleRate * oversamplingRate));
+			filter2[g].setSampleTime(1.f / (sampleRate * oversamplingRate));
+		}
+	}
+
+	void setModSampleRateReduction(size_t arg) override
+	{
+		for (int g = 0; g < groups; g++)
+		{
+			lfo1[g].setSampleRateReduction(arg);
+			lfo2[g].setSampleRateReduction(arg);
+
+			drift1[g].setSampleRateReduction(arg);
+			drift1[g].setFilterFrequencyV(synth->getParam(DRIFT_RATE_PARAM).getValue());
+			drift2[g].setSampleRateReduction(arg);
+			drift2[g].setFilterFrequencyV(synth->getParam(DRIFT_RATE_PARAM).getValue());
+		}
+	}
+
+	void seed(uint64_t s) override
+	{
+		// a stream per generator
+		for (int g = 0; g < groups; g++)
+		{
+			rng[g].seed(s, 1 + g);
+			drift1[g].seed(s, 1 + groups + g);
+			drift2[g].seed(s, 1 + 2 * groups + g);
+		}
+	}
+
+	void setDiverge(const float* diverge1, const float* diverge2) override
+	{
+		for (int g = 0; g < groups; g++)
+		{
+			drift1[g].setDiverge(T::load(&diverge1[g * T::size]));
+			drift2[g].setDiverge(T::load(&diverge2[g * T::size]));
+		}
+	}
+
+	void setFilterMethod(Method m) override
+	{
+		for (int g = 0; g < groups; g++)
+		{
+			filter1[g].setMethod(m);
+			filter2[g].setMethod(m);
+		}
+	}
+
+	void setFilterIntegratorType(IntegratorType t) override
+	{
+		for (int g = 0; g < groups; g++)
+		{
+			filter1[g].setIntegratorType(t);
+			filter2[g].setIntegratorType(t);
+		}
+	}
+
+	void updateDelayLines() override
+	{
+		for (int g = 0; g < groups; g++)
+		{
+			filter1[g].updateDelayLine();
+			filter2[g].updateDelayLine();
+		}
+	}
+
+	void updateSettings(int channels) override
+	{
+		for (int g = 0; g * T::size < channels; g++)
+		{
+			int c = g * T::size;
+			if (channels < 2)
+			{
+				modMatrixInputs[VOICE_NR_ASSIGN_PARAM + 1][g] = 0.f;
+			}
+			else
+			{
+				for (int iChannel = c; iChannel < std::min(channels, c + T::size); iChannel++)
+				{
+					modMatrixInputs[VOICE_NR_ASSIGN_PARAM + 1][g][iChannel - c] = 10.f * ((iChannel) / (channels - 1.f)) - 5.f;
+				}
+			}
+
+			env1[g].setVelocityScaling(synth->getParam(ENV1_VEL_PARAM).getValue());
+			env2[g].setVelocityScaling(synth->getParam(ENV2_VEL_PARAM).getValue());
+
+			lfo1[g].setShape(synth->getParam(LFO1_SHAPE_PARAM).getValue());
+			lfo1[g].setSingleCycle(synth->getParam(LFO1_MODE_PARAM).getValue() == 2);
+			lfo2[g].setShape(synth->getParam(LFO2_SHAPE_PARAM).getValue());
+			lfo2[g].setSingleCycle(synth->getParam(LFO2_MODE_PARAM).getValue() == 2);
+
+			drift1[g].setFilterFrequencyV(synth->getParam(DRIFT_RATE_PARAM).getValue());
+			drift2[g].setFilterFrequencyV(synth->getParam(DRIFT_RATE_PARAM).getValue());
+
+			oscillators[g].setSync(synth->getParam(OSC_SYNC_PARAM).getValue());
+
+			filter1[g].setMode(synth->getParam(FILTER1_MODE_PARAM).getValue());
+			filter2[g].setMode(synth->getParam(FILTER2_MODE_PARAM).getValue());
+		}
+	}
+
+	void reset() override
+	{
+		for (int g = 0; g < groups; g++)
+		{
+			lfo1[g].resetPhases();
+			lfo2[g].resetPhases();
+
+			filter1[g].reset();
+			filter2[g].reset();
+		}
+	}
+
+	/** the slice of voice group g of a per channel array */
+	static T load(const float* x, int g)
+	{
+		return T::load(&x[g * T::size]);
+	}
+
+	void processModulation(Block& block, int g, int frame) override
+	{
+		const ProcessArgs& args = block.args;
+		int c = g * T::size;
+
+		// get modulation inputs
+		for (size_t iInput = 0; iInput < INDIVIDUAL_MOD_2_ASSIGN_PARAM; iInput++)
+		{
+			modMatrixInputs[iInput + 1][g] = load(block.inputs[frame][iInput], g);
+		}
+
+		T triggerInput = load(block.inputs[frame][GATE_INPUT], g) + load(block.inputs[frame][RETRIGGER_INPUT], g);
+		T rnd = rng[g].uniform();
+		modMatrixInputs[RANDOM_ASSIGN_PARAM + 1][g] = ifelse(triggerInput > lastTrigger[g] + 0.5f,
+				(10.f * rnd) - 5.f,
+				modMatrixInputs[RANDOM_ASSIGN_PARAM + 1][g]);
+
+		// process modulation blocks
+		env1[g].setGate(load(block.inputs[frame][GATE_INPUT], g));
+		env1[g].setRetrigger(load(block.inputs[frame][RETRIGGER_INPUT], g));
+		env1[g].setVelocity(load(block.inputs[frame][VELOCITY_INPUT], g));
+		modMatrixInputs[ENV1_ASSIGN_PARAM + 1][g] = env1[g].process(args.sampleTime * synth->modDivider.getDivision());
+
+		env2[g].setGate(load(block.inputs[frame][GATE_INPUT], g));
+		env2[g].setRetrigger(load(block.inputs[frame][RETRIGGER_INPUT], g));
+		env2[g].setVelocity(load(block.inputs[frame][VELOCITY_INPUT], g));
+		modMatrixInputs[ENV2_ASSIGN_PARAM + 1][g] = env2[g].process(args.sampleTime * synth->modDivider.getDivision());
+
+		if (synth->getParam(LFO1_MODE_PARAM).getValue() > 0)
+		{
+			lfo1[g].setReset(triggerInput);
+		}
+		lfo1[g].process();
+		modMatrixInputs[LFO1_UNIPOLAR_ASSIGN_PARAM + 1][g] = lfo1[g].getUnipolar();
+		modMatrixInputs[LFO1_BIPOLAR_ASSIGN_PARAM + 1][g] = lfo1[g].getBipolar();
+
+		if (synth->getParam(LFO2_MODE_PARAM).getValue() > 0)
+		{
+			lfo2[g].setReset(triggerInput);
+		}
+		lfo2[g].process();
+		modMatrixInputs[LFO2_UNIPOLAR_ASSIGN_PARAM + 1][g] = lfo2[g].getUnipolar();
+		modMatrixInputs[LFO2_BIPOLAR_ASSIGN_PARAM + 1][g] = lfo2[g].getBipolar();
+
+		modMatrixInputs[GLOBAL_LFO_ASSIGN_PARAM + 1][g] = clamp(modMatrixOutputs[GLOBAL_LFO_AMT_PARAM - ENV1_A_PARAM][g], 0.f, 10.f) * load(block.globalLfo[frame], g);
+
+		modMatrixInputs[DIVERGE_1_ASSIGN_PARAM + 1][g] = 0.2f * modMatrixOutputs[DRIFT_AMOUNT_PARAM - ENV1_A_PARAM][g] * drift1[g].getDiverge();
+		modMatrixInputs[DIVERGE_2_ASSIGN_PARAM + 1][g] = 0.2f * modMatrixOutputs[DRIFT_AMOUNT_PARAM - ENV1_A_PARAM][g] * drift2[g].getDiverge();
+		modMatrixInputs[DRIFT_1_ASSIGN_PARAM + 1][g] = 0.2f * modMatrixOutputs[DRIFT_AMOUNT_PARAM - ENV1_A_PARAM][g] * drift1[g].process();
+		modMatrixInputs[DRIFT_2_ASSIGN_PARAM + 1][g] = 0.2f * modMatrixOutputs[DRIFT_AMOUNT_PARAM - ENV1_A_PARAM][g] * drift2[g].process();
+
+		// matrix multiplication, only the non-zero entries
+		for (size_t iDest = 0; iDest < nDestinations; iDest++)
+		{
+			modMatrixOutputs[iDest][g] = synth->modMatrix[iDest][0];
+		}
+		for (size_t i = 0; i < synth->nModTerms; i++)
+		{
+			const ModTerm& term = synth->modTerms[i];
+			modMatrixOutputs[term.dest][g] += term.amount * modMatrixInputs[term.source][g];
+		}
+		for (size_t i = 0; i < synth->nAmpVolTerms; i++)
+		{
+			const ModTerm& term = synth->ampVolTerms[i];
+			T mult = 0.1f * (10.f + term.amount * (modMatrixInputs[term.source][g] - sgn(term.amount) * 10.f));
+			mult -= (term.amount < 0.f) * term.amount;
+			mult = clamp(mult, 0.f, 1.f);
+			modMatrixOutputs[AMP_VOL_PARAM - ENV1_A_PARAM][g] *= mult;
+		}
+
+		// voice group sleep: stop rendering audio when all voices of the group are released and silent
+		int usedVoices = (1 << std::min(block.channels - c, (int)T::size)) - 1;
+		T silent = env1[g].getReleased() & (simd::fabs(0.1f * modMatrixOutputs[AMP_VOL_PARAM - ENV1_A_PARAM][g]) < T(SLEEP_THRESHOLD));
+		if (!synth->voiceSleep || (simd::movemask(silent) & usedVoices) != usedVoices)
+		{
+			if (groupSleeping[g])
+			{
+				wakeGroup(g);
+			}
+			groupSilentTime[g] = 0.f;
+		}
+		else if (!groupSleeping[g])
+		{
+			groupSilentTime[g] += args.sampleTime * synth->modDivider.getDivision();
+			groupSleeping[g] = groupSilentTime[g] >= SLEEP_DELAY;
+		}
+
+		// calculate further values
+		T noiseAmp = clamp(modMatrixOutputs[OSC_NOISE_VOL_PARAM - ENV1_A_PARAM][g], 0.f, 10.f);
+		T noiseMix = clamp(0.2f * modMatrixOutputs[OSC_NOISE_VOL_PARAM + nMixChannels - ENV1_A_PARAM][g], -1.f, 1.f);
+		T* noiseVol1Target = rampTarget[NOISE_VOL_1_RAMP];
+		T* noiseVol2Target = rampTarget[NOISE_VOL_2_RAMP];
+		noiseVol1Target[g] = 0.5f - 0.5f * noiseMix;
+		noiseVol2Target[g] = 1.f - noiseVol1Target[g];
+		noiseVol1Target[g] *= noiseAmp;
+		noiseVol2Target[g] *= noiseAmp;
+		// add -90db noise to bootstrap filter self oscillation
+		noiseVol1Target[g] = fmax(noiseVol1Target[g], 3.e-5f);
+		noiseVol2Target[g] = fmax(noiseVol2Target[g], 3.e-5f);
+
+		T extAmp = clamp(0.1f * modMatrixOutputs[OSC_EXT_VOL_PARAM - ENV1_A_PARAM][g], 0.f, 1.f);
+		T extMix = clamp(0.2f * modMatrixOutputs[OSC_EXT_VOL_PARAM + nMixChannels - ENV1_A_PARAM][g], -1.f, 1.f);
+		T* extVol1Target = rampTarget[EXT_VOL_1_RAMP];
+		T* extVol2Target = rampTarget[EXT_VOL_2_RAMP];
+		extVol1Target[g] = 0.5f - 0.5f * extMix;
+		extVol2Target[g] = 1.f - extVol1Target[g];
+		extVol1Target[g] *= extAmp;
+		extVol2Target[g] *= extAmp;
+
+		// set modulated parameters
+		env1[g].setAttackTime(0.1f * modMatrixOutputs[ENV1_A_PARAM - ENV1_A_PARAM][g]);
+		env1[g].setDecayTime(0.1f * modMatrixOutputs[ENV1_D_PARAM - ENV1_A_PARAM][g]);
+		env1[g].setSustainLevel(0.1f * modMatrixOutputs[ENV1_S_PARAM - ENV1_A_PARAM][g]);
+		env1[g].setReleaseTime(0.1f * modMatrixOutputs[ENV1_R_PARAM - ENV1_A_PARAM][g]);
+
+		env2[g].setAttackTime(0.1f * modMatrixOutputs[ENV2_A_PARAM - ENV1_A_PARAM][g]);
+		env2[g].setDecayTime(0.1f * modMatrixOutputs[ENV2_D_PARAM - ENV1_A_PARAM][g]);
+		env2[g].setSustainLevel(0.1f * modMatrixOutputs[ENV2_S_PARAM - ENV1_A_PARAM][g]);
+		env2[g].setReleaseTime(0.1f * modMatrixOutputs[ENV2_R_PARAM - ENV1_A_PARAM][g]);
+
+		lfo1[g].setRand(block.noise1[frame]);
+		lfo1[g].setFrequencyVOct(modMatrixOutputs[LFO1_FREQ_PARAM - ENV1_A_PARAM][g]);
+		lfo1[g].setAmp(modMatrixOutputs[LFO1_AMOUNT_PARAM - ENV1_A_PARAM][g]);
+
+		lfo2[g].setRand(block.noise2[frame]);
+		lfo2[g].setFrequencyVOct(modMatrixOutputs[LFO2_FREQ_PARAM - ENV1_A_PARAM][g]);
+		lfo2[g].setAmp(modMatrixOutputs[LFO2_AMOUNT_PARAM - ENV1_A_PARAM][g]);
+
+		modMatrixOutputs[INDIVIDUAL_MOD_OUT_1_PARAM - ENV1_A_PARAM][g].store(&block.modOutputs[frame][INDIVIDUAL_MOD_1_OUTPUT][g * T::size]);
+		modMatrixOutputs[INDIVIDUAL_MOD_OUT_2_PARAM - ENV1_A_PARAM][g].store(&block.modOutputs[frame][INDIVIDUAL_MOD_2_OUTPUT][g * T::size]);
+		modMatrixOutputs[INDIVIDUAL_MOD_OUT_3_PARAM - ENV1_A_PARAM][g].store(&block.modOutputs[frame][INDIVIDUAL_MOD_3_OUTPUT][g * T::size]);
+		modMatrixOutputs[INDIVIDUAL_MOD_OUT_4_PARAM - ENV1_A_PARAM][g].store(&block.modOutputs[frame][INDIVIDUAL_MOD_4_OUTPUT][g * T::size]);
+		modMatrixOutputs[INDIVIDUAL_MOD_OUT_5_PARAM - ENV1_A_PARAM][g].store(&block.modOutputs[frame][INDIVIDUAL_MOD_5_OUTPUT][g * T::size]);
+
+		// glide only on V/Oct
+		T vOctInput = load(block.inputs[frame][VOCT_INPUT], g);
+		T gateInput = load(block.inputs[frame][GATE_INPUT], g);
+		T osc1FreqVOct = synth->getParam(OSC1_TUNE_OCT_PARAM).getValue() +
+				modMatrixOutputs[OSC1_TUNE_SEMI_PARAM - ENV1_A_PARAM][g] / 5.f -
+				synth->modMatrix[OSC1_TUNE_SEMI_PARAM - ENV1_A_PARAM][VOCT_ASSIGN_PARAM + 1] * vOctInput / 5.f +
+				modMatrixOutputs[OSC1_TUNE_FINE_PARAM - ENV1_A_PARAM][g] / 5.f / 12.f;
+		glide1[g].setCutoffFreq(synth->getGlideFreq(modMatrixOutputs[OSC1_TUNE_GLIDE_PARAM - ENV1_A_PARAM][g], args.sampleRate));
+		if (synth->getParam(OSC_TUNE_GLIDE_FINGERED_PARAM).getValue())
+		{
+			glide1[g].setState(vOctInput, gateInput > lastGate[g] + 0.5f);
+		}
+		rampTarget[OSC1_FREQ_RAMP][g] = osc1FreqVOct +
+				synth->modMatrix[OSC1_TUNE_SEMI_PARAM - ENV1_A_PARAM][VOCT_ASSIGN_PARAM + 1] / 5.f * glide1[g].processLowpass(vOctInput);
+
+		rampTarget[OSC1_SHAPE_RAMP][g] = 0.2f * modMatrixOutputs[OSC1_SHAPE_PARAM - ENV1_A_PARAM][g] - 1.f;
+		rampTarget[OSC1_PW_RAMP][g] = 0.2f * modMatrixOutputs[OSC1_PW_PARAM - ENV1_A_PARAM][g] - 1.f;
+		rampTarget[OSC1_VOL_RAMP][g] = 0.1f * modMatrixOutputs[OSC1_VOL_PARAM - ENV1_A_PARAM][g];
+		rampTarget[OSC1_PAN_RAMP][g] = 0.2f * modMatrixOutputs[OSC1_VOL_PARAM + nMixChannels - ENV1_A_PARAM][g];
+		rampTarget[OSC1_SUB_VOL_RAMP][g] = 0.1f * modMatrixOutputs[OSC1_SUB_VOL_PARAM - ENV1_A_PARAM][g];
+		rampTarget[OSC1_SUB_PAN_RAMP][g] = 0.2f * modMatrixOutputs[OSC1_SUB_VOL_PARAM + nMixChannels - ENV1_A_PARAM][g];
+
+		T osc2FreqVOct = synth->getParam(OSC2_TUNE_OCT_PARAM).getValue() +
+				modMatrixOutputs[OSC2_TUNE_SEMI_PARAM - ENV1_A_PARAM][g] / 5.f -
+				synth->modMatrix[OSC2_TUNE_SEMI_PARAM - ENV1_A_PARAM][VOCT_ASSIGN_PARAM + 1] * vOctInput / 5.f +
+				modMatrixOutputs[OSC2_TUNE_FINE_PARAM - ENV1_A_PARAM][g] / 5.f / 12.f;
+		glide2[g].setCutoffFreq(synth->getGlideFreq(modMatrixOutputs[OSC1_TUNE_GLIDE_PARAM - ENV1_A_PARAM][g] + modMatrixOutputs[OSC2_TUNE_GLIDE_PARAM - ENV1_A_PARAM][g], args.sampleRate));
+		if (synth->getParam(OSC_TUNE_GLIDE_FINGERED_PARAM).getValue())
+		{
+			glide2[g].setState(vOctInput, gateInput > lastGate[g] + 0.5f);
+		}
+		rampTarget[OSC2_FREQ_RAMP][g] = osc2FreqVOct +
+				synth->modMatrix[OSC2_TUNE_SEMI_PARAM - ENV1_A_PARAM][VOCT_ASSIGN_PARAM + 1] / 5.f * glide2[g].processLowpass(vOctInput);
+
+		rampTarget[OSC2_SHAPE_RAMP][g] = 0.2f * modMatrixOutputs[OSC2_SHAPE_PARAM - ENV1_A_PARAM][g] - 1.f;
+		rampTarget[OSC2_PW_RAMP][g] = 0.2f * modMatrixOutputs[OSC2_PW_PARAM - ENV1_A_PARAM][g] - 1.f;
+		rampTarget[OSC2_VOL_RAMP][g] = 0.1f * modMatrixOutputs[OSC2_VOL_PARAM - ENV1_A_PARAM][g];
+		rampTarget[OSC2_PAN_RAMP][g] = 0.2f * modMatrixOutputs[OSC2_VOL_PARAM + nMixChannels - ENV1_A_PARAM][g];
+
+		rampTarget[FM_AMOUNT_RAMP][g] = 0.1f * modMatrixOutputs[OSC_FM_AMOUNT_PARAM - ENV1_A_PARAM][g];
+		rampTarget[RM_VOL_RAMP][g] = 0.1f * modMatrixOutputs[OSC_RM_VOL_PARAM - ENV1_A_PARAM][g];
+		rampTarget[RM_PAN_RAMP][g] = 0.2f * modMatrixOutputs[OSC_RM_VOL_PARAM + nMixChannels - ENV1_A_PARAM][g];
+
+
+		// cutoff mode
+		switch ((int)synth->getParam(FILTER2_CUTOFF_MODE_PARAM).getValue())
+		{
+		case 0: // individual
+			rampTarget[FILTER1_CUTOFF_RAMP][g] = modMatrixOutputs[FILTER1_CUTOFF_PARAM - ENV1_A_PARAM][g];
+			rampTarget[FILTER2_CUTOFF_RAMP][g] = modMatrixOutputs[FILTER2_CUTOFF_PARAM - ENV1_A_PARAM][g];
+			break;
+		case 1: // offset
+			rampTarget[FILTER1_CUTOFF_RAMP][g] = modMatrixOutputs[FILTER1_CUTOFF_PARAM - ENV1_A_PARAM][g];
+			rampTarget[FILTER2_CUTOFF_RAMP][g] = modMatrixOutputs[FILTER1_CUTOFF_PARAM - ENV1_A_PARAM][g] + (modMatrixOutputs[FILTER2_CUTOFF_PARAM - ENV1_A_PARAM][g]) - 5.f;
+			break;
+		case 2: // space
+			rampTarget[FILTER1_CUTOFF_RAMP][g] = modMatrixOutputs[FILTER1_CUTOFF_PARAM - ENV1_A_PARAM][g] - (modMatrixOutputs[FILTER2_CUTOFF_PARAM - ENV1_A_PARAM][g] - 5.f);
+			rampTarget[FILTER2_CUTOFF_RAMP][g] = modMatrixOutputs[FILTER1_CUTOFF_PARAM - ENV1_A_PARAM][g] + (modMatrixOutputs[FILTER2_CUTOFF_PARAM - ENV1_A_PARAM][g] - 5.f);
+		}
+		rampTarget[FILTER1_RESONANCE_RAMP][g] = modMatrixOutputs[FILTER1_RESONANCE_PARAM - ENV1_A_PARAM][g];
+		rampTarget[FILTER2_RESONANCE_RAMP][g] = modMatrixOutputs[FILTER2_RESONANCE_PARAM - ENV1_A_PARAM][g];
+
+		rampTarget[FILTER1_PAN_RAMP][g] = modMatrixOutputs[FILTER1_PAN_PARAM - ENV1_A_PARAM][g];
+		rampTarget[FILTER2_PAN_RAMP][g] = modMatrixOutputs[FILTER2_PAN_PARAM - ENV1_A_PARAM][g];
+		rampTarget[AMP_VOL_RAMP][g] = modMatrixOutputs[AMP_VOL_PARAM - ENV1_A_PARAM][g];
+
+		startRamps(args, g);
+
+		lastGate[g] = gateInput;
+		lastTrigger[g] = triggerInput;
+	}
+
+	void processAudio(Block& block, int g, int frame, int frames, float_4* bufferLR) override
+	{
+		size_t oversamplingRate = synth->oversamplingRate;
+
+		if (groupSleeping[g])
+		{
+			return;
+		}
+
+		// the loopback feeds back the previous frame, so render frame by frame
+		bool loopback = !block.extConnected && simd::movemask((extVol1[g] != 0.f) | (extVol2[g] != 0.f) |
+				(rampTarget[EXT_VOL_1_RAMP][g] != 0.f) | (rampTarget[EXT_VOL_2_RAMP][g] != 0.f));
+
+		int end = frame + frames;
+		while (frame < end)
+		{
+			int chunk = end - frame;
+			if (loopback)
+			{
+				chunk = 1;
+			}
+			else if (rampFrames[g] > 0)
+			{
+				chunk = std::min(chunk, std::min(rampFrames[g], (int)rampChunkFrames));
+			}
+			renderVoiceGroup(block, g, frame, chunk, &bufferLR[frame * oversamplingRate]);
+			frame += chunk;
+		}
+	}
+
+	void renderVoiceGroup(Block& block, int g, int frame, int frames, float_4* bufferLR)
+	{
+		const ProcessArgs& args = block.args;
+		size_t oversamplingRate = synth->oversamplingRate;
+		int c = g * T::size;
+		int length = frames * oversamplingRate;
+
+		// the levels and pans are ramped sample by sample from where the previous call left them
+		T noiseVol1Start = noiseVol1[g];
+		T noiseVol2Start = noiseVol2[g];
+		T extVol1Start = extVol1[g];
+		T extVol2Start = extVol2[g];
+		T pan1Start = rampValue[FILTER1_PAN_RAMP][g];
+		T pan2Start = rampValue[FILTER2_PAN_RAMP][g];
+		T ampStart = rampValue[AMP_VOL_RAMP][g];
+
+		if (rampFrames[g] > 0)
+		{
+			advanceRamps(args, g, frames);
+		}
+
+		// the first frame of the group buffers is the last frame of the previous call,
+		// to bring filter 1 and 2 in phase also with serial routing
+		std::memcpy(groupBuffer1[g], delayBuffer1[g], oversamplingRate * sizeof(T));
+		std::memcpy(groupBuffer2[g], delayBuffer2[g], oversamplingRate * sizeof(T));
+		T* buffer1 = &groupBuffer1[g][oversamplingRate];
+		T* buffer2 = &groupBuffer2[g][oversamplingRate];
+
+		// oscillators
+		for (int i = 0; i < frames; i++)
+		{
+			oscillators[g].processBandlimited(&buffer1[i * oversamplingRate], &buffer2[i * oversamplingRate]);
+		}
+
+		// external input/loopback & noise
+		if (block.extConnected)
+		{
+			for (int i = 0; i < frames; i++)
+			{
+				T noise = rng[g].normal();
+				T extIn = load(block.inputs[frame + i][EXT_INPUT], g);
+				T position = (i + 1.f) / frames;
+				T extVol1Frame = crossfade(extVol1Start, extVol1[g], position);
+				T extVol2Frame = crossfade(extVol2Start, extVol2[g], position);
+				T noiseVol1Frame = crossfade(noiseVol1Start, noiseVol1[g], position);
+				T noiseVol2Frame = crossfade(noiseVol2Start, noiseVol2[g], position);
+				for (size_t iSample = i * oversamplingRate; iSample < (i + 1) * oversamplingRate; iSample++)
+				{
+					// linear interpolation upsampling
+					buffer1[iSample] += extVol1Frame * crossfade(lastExtIn[g], extIn, (iSample - i * oversamplingRate + 1.f)/oversamplingRate);
+					buffer2[iSample] += extVol2Frame * crossfade(lastExtIn[g], extIn, (iSample - i * oversamplingRate + 1.f)/oversamplingRate);
+
+					buffer1[iSample] *= 2.f;
+					buffer2[iSample] *= 2.f;
+
+					buffer1[iSample] += noiseVol1Frame * noise;
+					buffer2[iSample] += noiseVol2Frame * noise;
+				}
+				lastExtIn[g] = extIn;
+			}
+		}
+		else
+		{
+			for (int i = 0; i < frames; i++)
+			{
+				T noise = rng[g].normal();
+				T position = (i + 1.f) / frames;
+				T noiseVol1Frame = crossfade(noiseVol1Start, noiseVol1[g], position);
+				T noiseVol2Frame = crossfade(noiseVol2Start, noiseVol2[g], position);
+				for (size_t iSample = i * oversamplingRate; iSample < (i + 1) * oversamplingRate; iSample++)
+				{
+					// frames is 1 if the loopback is active, so groupBuffer1/2 hold the previous frame
+					buffer1[iSample] += extVol1[g] * (groupBuffer1[g][iSample] + groupBuffer2[g][iSample]);
+					buffer2[iSample] += extVol2[g] * (groupBuffer1[g][iSample] + groupBuffer2[g][iSample]);
+
+					buffer1[iSample] += noiseVol1Frame * noise;
+					buffer2[iSample] += noiseVol2Frame * noise;
+				}
+			}
+		}
+
+		// keep the last frame of mix bus 2 for the next call
+		std::memcpy(delayBuffer2[g], &buffer2[length - oversamplingRate], oversamplingRate * sizeof(T));
+
+		// process filter 1
+		dcBlocker1[g].processHighpassBlock(buffer1, length);
+		aliasFilter1[g].processLowpassBlock(buffer1, length);
+		filter1[g].processBlock(buffer1, args.sampleTime / oversamplingRate, length);
+		saturator1[g].processBlockBandlimited(buffer1, length);
+
+		// serial routing, filter 2 processes the delayed mix bus 2 in place
+		T serPar = clamp(0.2f * modMatrixOutputs[FILTER_SERIAL_PARALLEL_PARAM - ENV1_A_PARAM][g] - 1.f, -1.f, 1.f);
+		T serial = 0.5f - 0.5f * serPar; // [1..0]
+		T* filter2Buffer = groupBuffer2[g];
+		for (int iSample = 0; iSample < length; iSample++)
+		{
+			filter2Buffer[iSample] += serial * buffer1[iSample];
+		}
+
+		// process filter 2
+		dcBlocker2[g].processHighpassBlock(filter2Buffer, length);
+		aliasFilter2[g].processLowpassBlock(filter2Buffer, length);
+		filter2[g].processBlock(filter2Buffer, args.sampleTime / oversamplingRate, length);
+		saturator2[g].processBlockBandlimited(filter2Buffer, length);
+
+		// parallel routing
+		T parallel = 0.5f + 0.5f * serPar; // [0..1]
+		for (int iSample = 0; iSample < length; iSample++)
+		{
+			buffer1[iSample] *= parallel;
+		}
+
+		// keep the last frame of filter 1 for the next call, and use the delayed filter 1 output
+		std::memcpy(delayBuffer1[g], &buffer1[length - oversamplingRate], oversamplingRate * sizeof(T));
+		T* filter1Buffer = groupBuffer1[g];
+
+		// pan, amp, the gains at the start and the end of this call are interpolated sample by sample
+		Gains start = getGains(pan1Start, pan2Start, ampStart, block.channels - c);
+		Gains end = getGains(rampValue[FILTER1_PAN_RAMP][g], rampValue[FILTER2_PAN_RAMP][g], rampValue[AMP_VOL_RAMP][g], block.channels - c);
+		if (start == end)
+		{
+			for (int iSample = 0; iSample < length; iSample++)
+			{
+				T out1 = end.amp * filter1Buffer[iSample];
+				T out2 = end.amp * filter2Buffer[iSample];
+
+				// sum the voices to stereo and to the filter outputs
+				bufferLR[iSample] += sumLanes(end.vol1L * out1 + end.vol2L * out2, end.vol1R * out1 + end.vol2R * out2, out1, out2);
+			}
+		}
+		else
+		{
+			Gains step = (end - start) * (1.f / length);
+			Gains gains = start;
+			for (int iSample = 0; iSample < length; iSample++)
+			{
+				gains += step;
+				T out1 = gains.amp * filter1Buffer[iSample];
+				T out2 = gains.amp * filter2Buffer[iSample];
+
+				bufferLR[iSample] += sumLanes(gains.vol1L * out1 + gains.vol2L * out2, gains.vol1R * out1 + gains.vol2R * out2, out1, out2);
+			}
+		}
+	}
+
+	/** output gains of a voice group */
+	struct Gains {
+		T vol1L, vol1R, vol2L, vol2R, amp;
+
+		bool operator==(const Gains& o) const
+		{
+			return !simd::movemask((vol1L != o.vol1L) | (vol1R != o.vol1R) | (vol2L != o.vol2L) | (vol2R != o.vol2R) | (amp != o.amp));
+		}
+
+		Gains operator-(const Gains& o) const
+		{
+			return {vol1L - o.vol1L, vol1R - o.vol1R, vol2L - o.vol2L, vol2R - o.vol2R, amp - o.amp};
+		}
+
+		Gains operator*(float f) const
+		{
+			return {vol1L * f, vol1R * f, vol2L * f, vol2R * f, amp * f};
+		}
+
+		Gains& operator+=(const Gains& o)
+		{
+			vol1L += o.vol1L;
+			vol1R += o.vol1R;
+			vol2L += o.vol2L;
+			vol2R += o.vol2R;
+			amp += o.amp;
+			return *this;
+		}
+	};
+
+	/** pan and amp ramp values to gains, usedVoices is the number of voices in the group that are played */
+	static Gains getGains(T pan1Ramp, T pan2Ramp, T ampRamp, int usedVoices)
+	{
+		T pan1 = clamp(0.2f * pan1Ramp, -1.f, 1.f);
+		T pan2 = clamp(0.2f * pan2Ramp, -1.f, 1.f);
+		// the amp is 0 for unused voices of the last group
+		T lane = 0.f;
+		for (int j = 0; j < T::size; j++)
+		{
+			lane[j] = j;
+		}
+		// constant power pan law
+		return {panGetVolL<T>(pan1), panGetVolR<T>(pan1), panGetVolL<T>(pan2), panGetVolR<T>(pan2),
+			ifelse(lane < T(usedVoices), 0.1f * ampRamp, 0.f)};
+	}
+
+	/** ramp to the new targets over one modulation interval, or jump to them right away */
+	void startRamps(const ProcessArgs& args, int g)
+	{
+		int frames = synth->interpolateModulation ? synth->modDivider.getDivision() : 1;
+		if (frames == 1)
+		{
+			for (int i = 0; i < RAMPS_LEN; i++)
+			{
+				rampValue[i][g] = rampTarget[i][g];
+			}
+			rampFrames[g] = 0;
+			applyRamps(args, g);
+			return;
+		}
+
+		int changed = 0;
+		for (int i = 0; i < RAMPS_LEN; i++)
+		{
+			rampStep[i][g] = (rampTarget[i][g] - rampValue[i][g]) * (1.f / frames);
+			changed |= simd::movemask(rampTarget[i][g] != rampValue[i][g]);
+		}
+		rampFrames[g] = changed ? frames : 0;
+	}
+
+	/** advances the ramps by frames */
+	void advanceRamps(const ProcessArgs& args, int g, int frames)
+	{
+		rampFrames[g] -= frames;
+		if (rampFrames[g] > 0)
+		{
+			for (int i = 0; i < RAMPS_LEN; i++)
+			{
+				rampValue[i][g] += (float)frames * rampStep[i][g];
+			}
+		}
+		else
+		{
+			for (int i = 0; i < RAMPS_LEN; i++)
+			{
+				rampValue[i][g] = rampTarget[i][g];
+			}
+		}
+		applyRamps(args, g);
+	}
+
+	void applyRamps(const ProcessArgs& args, int g)
+	{
+		size_t oversamplingRate = synth->oversamplingRate;
+
+		oscillators[g].setOsc1FreqVOct(rampValue[OSC1_FREQ_RAMP][g]);
+		oscillators[g].setOsc1Shape(rampValue[OSC1_SHAPE_RAMP][g]);
+		oscillators[g].setOsc1PW(rampValue[OSC1_PW_RAMP][g]);
+		oscillators[g].setOsc1Vol(rampValue[OSC1_VOL_RAMP][g]);
+		oscillators[g].setOsc1Pan(rampValue[OSC1_PAN_RAMP][g]);
+		oscillators[g].setOsc1Subvol(rampValue[OSC1_SUB_VOL_RAMP][g]);
+		oscillators[g].setOsc1SubPan(rampValue[OSC1_SUB_PAN_RAMP][g]);
+
+		oscillators[g].setOsc2FreqVOct(rampValue[OSC2_FREQ_RAMP][g]);
+		oscillators[g].setOsc2Shape(rampValue[OSC2_SHAPE_RAMP][g]);
+		oscillators[g].setOsc2PW(rampValue[OSC2_PW_RAMP][g]);
+		oscillators[g].setOsc2Vol(rampValue[OSC2_VOL_RAMP][g]);
+		oscillators[g].setOsc2Pan(rampValue[OSC2_PAN_RAMP][g]);
+
+		oscillators[g].setFmAmount(rampValue[FM_AMOUNT_RAMP][g]);
+		oscillators[g].setRingmodVol(rampValue[RM_VOL_RAMP][g]);
+		oscillators[g].setRingmodPan(rampValue[RM_PAN_RAMP][g]);
+
+		noiseVol1[g] = rampValue[NOISE_VOL_1_RAMP][g];
+		noiseVol2[g] = rampValue[NOISE_VOL_2_RAMP][g];
+		extVol1[g] = rampValue[EXT_VOL_1_RAMP][g];
+		extVol2[g] = rampValue[EXT_VOL_2_RAMP][g];
+
+		T filterFrequency = fastExp(synth->filterLogBase * 0.1f * rampValue[FILTER1_CUTOFF_RAMP][g]) * synth->filterMinFreq;
+		filterFrequency = simd::clamp(filterFrequency, synth->filterMinFreq, simd::fmin(2.f * synth->filterMaxFreq, args.sampleRate * oversamplingRate * 0.18f));
+		filter1[g].setCutoffFrequencyAndResonance(
+				filterFrequency,
+				0.5f * rampValue[FILTER1_RESONANCE_RAMP][g]);
+
+		filterFrequency = fastExp(synth->filterLogBase * 0.1f * rampValue[FILTER2_CUTOFF_RAMP][g]) * synth->filterMinFreq;
+		filterFrequency = simd::clamp(filterFrequency, synth->filterMinFreq, simd::fmin(2.f * synth->filterMaxFreq, args.sampleRate * oversamplingRate * 0.18f));
+		filter2[g].setCutoffFrequencyAndResonance(
+				filterFrequency,
+				0.5f * rampValue[FILTER2_RESONANCE_RAMP][g]);
+	}
+
+	// clear the audio path of a sleeping voice group, so it starts from silence
+	void wakeGroup(int g)
+	{
+		dcBlocker1[g].reset();
+		aliasFilter1[g].reset();
+		filter1[g].reset();
+		saturator1[g].reset();
+		dcBlocker2[g].reset();
+		aliasFilter2[g].reset();
+		filter2[g].reset();
+		saturator2[g].reset();
+		std::memset(delayBuffer1[g], 0, sizeof(delayBuffer1[g]));
+		std::memset(delayBuffer2[g], 0, sizeof(delayBuffer2[g]));
+		groupSleeping[g] = false;
+	}
+};
+
+}
@@ -0,0 +1,17 @@
+// the Synth voices with 8 voices per group, built with -mavx2 -mfma on x64
+// only called when the CPU supports AVX2 and FMA, see Synth::createVoices()
+#include "dsp/float_8.hpp"
+#include "Synth.hpp"
+
+namespace musx {
+
+Synth::Voices* Synth::createAvxVoices(Synth* synth)
+{
+	#if defined(__AVX2__) && defined(__FMA__)
+	return new TVoices<simd::float_8>(synth);
+	#else
+	return nullptr;
+	#endif
+}
+
+}
@@ -0,0 +1,1229 @@
+// Headless benchmark and offline render harness for the musx modules.
+//
+// Builds against the minimal Rack stand-in in src/bench/rack, so it neither
+// needs the Rack SDK nor a running engine. Modules are created from the
+// plugin's models and driven only through the Module interface: params and
+// ports are looked up by name, context menu settings are applied through
+// dataToJson() / dataFromJson().
+//
+// Build and run with `make bench`, see `build/bench --help` for options.
+
+#include <rack.hpp>
+
+#include "blocks/FilterBlock.hpp"
+#include "components/DeferredAllocation.hpp"
+#include "dsp/decimator.hpp"
+#include "dsp/functions.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace rack;
+
+void init(Plugin* p);
+
+namespace musx {
+namespace bench {
+
+struct Options {
+	float seconds = 2.f;
+	float sampleRate = 48000.f;
+	std::vector<int> channels = {1, 4, 16};
+	std::vector<int> oversampling = {1, 4, 16};
+	std::vector<int> methods;
+	std::vector<int> integrators;
+	std::vector<int> filterModes;
+	int notes = 0; // held notes in the synth suite, 0: every voice
+	std::vector<std::pair<std::string, std::string>> synthData; // extra settings for the synth suite, values in JSON
+	std::string preset = "presets/Synth/template.vcvm";
+	std::string wavDirectory;
+	std::vector<std::string> suites;
+};
+
+static const std::vector<std::string> methodNames = {"euler", "rk2", "rk4"};
+static const std::vector<std::string> integratorNames = {"linear", "ota_tanh", "ota_alt", "transistor_tanh", "transistor_alt"};
+
+
+/** Owns one module instance and feeds it samples like the Rack engine would */
+struct Runner {
+	Module* module = nullptr;
+	musx::DeferredAllocation* deferredAllocation = nullptr; // what the module widget would do in step()
+	float sampleRate;
+	int64_t frame = 0;
+
+	Runner(Model* model, float sampleRate, int64_t id = 1) : sampleRate(sampleRate)
+	{
+		module = model->createModule();
+		module->id = id;
+
+		Module::AddEvent eAdd;
+		module->onAdd(eAdd);
+
+		Module::SampleRateChangeEvent eSampleRate;
+		eSampleRate.sampleRate = sampleRate;
+		eSampleRate.sampleTime = 1.f / sampleRate;
+		module->onSampleRateChange(eSampleRate);
+
+		deferredAllocation = dynamic_cast<musx::DeferredAllocation*>(module);
+
+		// behave as if every output had a cable connected
+		for (Output& output : module->outputs)
+		{
+			output.channels = 1;
+		}
+	}
+
+	~Runner()
+	{
+		delete module;
+	}
+
+	int findParam(const std::string& name)
+	{
+		for (size_t i = 0; i < module->paramQuantities.size(); i++)
+		{
+			if (module->paramQuantities[i] && module->paramQuantities[i]->name == name)
+			{
+				return i;
+			}
+		}
+		std::fprintf(stderr, "%s: no param named \"%s\"\n", module->model->slug.c_str(), name.c_str());
+		std::exit(1);
+	}
+
+	int findInput(const std::string& name)
+	{
+		for (size_t i = 0; i < module->inputInfos.size(); i++)
+		{
+			if (module->inputInfos[i] && module->inputInfos[i]->name == name)
+			{
+				return i;
+			}
+		}
+		std::fprintf(stderr, "%s: no input named \"%s\"\n", module->model->slug.c_str(), name.c_str());
+		std::exit(1);
+	}
+
+	int findOutput(const std::string& name)
+	{
+		for (size_t i = 0; i < module->outputInfos.size(); i++)
+		{
+			if (module->outputInfos[i] && module->outputInfos[i]->name == name)
+			{
+				return i;
+			}
+		}
+		std::fprintf(stderr, "%s: no output named \"%s\"\n", module->model->slug.c_str(), name.c_str());
+		std::exit(1);
+	}
+
+	void setParam(const std::string& name, float value)
+	{
+		module->params[findParam(name)].setValue(value);
+	}
+
+	std::vector<std::string> getParamLabels(const std::string& name)
+	{
+		SwitchQuantity* sq = dynamic_cast<SwitchQuantity*>(module->paramQuantities[findParam(name)]);
+		return sq ? sq->labels : std::vector<std::string>();
+	}
+
+	/** Changes a context menu setting through the module's JSON data */
+	void setData(const char* key, json_t* valueJ)
+	{
+		json_t* rootJ = module->dataToJson();
+		if (!rootJ)
+		{
+			rootJ = json_object();
+		}
+		json_object_set_new(rootJ, key, valueJ);
+		module->dataFromJson(rootJ);
+		json_decref(rootJ);
+	}
+
+	/** Loads a .vcvm preset the same way Rack does: params first, then the module data */
+	bool loadPreset(const std::string& path)
+	{
+		json_error_t error;
+		json_t* presetJ = json_load_file(path.c_str(), 0, &error);
+		if (!presetJ)
+		{
+			std::fprintf(stderr, "%s\n", error.text);
+			return false;
+		}
+
+		json_t* paramsJ = json_object_get(presetJ, "params");
+		for (size_t i = 0; i < json_array_size(paramsJ); i++)
+		{
+			json_t* paramJ = json_array_get(paramsJ, i);
+			int paramId = json_integer_value(json_object_get(paramJ, "id"));
+			if (paramId >= 0 && paramId < (int)module->params.size())
+			{
+				module->params[paramId].setValue(json_number_value(json_object_get(paramJ, "value")));
+			}
+		}
+
+		json_t* dataJ = json_object_get(presetJ, "data");
+		if (dataJ)
+		{
+			module->dataFromJson(dataJ);
+		}
+
+		json_decref(presetJ);
+		return true;
+	}
+
+	void process()
+	{
+		Module::ProcessArgs args;
+		args.sampleRate = sampleRate;
+		args.sampleTime = 1.f / sampleRate;
+		args.frame = frame++;
+		module->process(args);
+
+		// about the rate of the UI thread
+		if (deferredAllocation && frame % 512 == 0)
+		{
+			deferredAllocation->allocateAndFree();
+		}
+	}
+};
+
+
+/** Collects output statistics, so that a broken change does not go unnoticed as a fast one */
+struct OutputStats {
+	double sumSquares = 0.;
+	float peak = 0.f;
+	int64_t nonFinite = 0;
+	int64_t n = 0;
+
+	void add(float x)
+	{
+		if (!std::isfinite(x))
+		{
+			nonFinite++;
+			return;
+		}
+		sumSquares += x * x;
+		peak = std::max(peak, std::fabs(x));
+		n++;
+	}
+
+	float rms() const
+	{
+		return n ? std::sqrt(sumSquares / n) : 0.f;
+	}
+};
+
+
+struct WavWriter {
+	FILE* f = nullptr;
+	uint32_t frames = 0;
+	int channels;
+
+	WavWriter(const std::string& path, int channels, int sampleRate) : channels(channels)
+	{
+		f = std::fopen(path.c_str(), "wb");
+		if (!f)
+		{
+			std::fprintf(stderr, "cannot write %s\n", path.c_str());
+			return;
+		}
+		writeHeader(sampleRate);
+	}
+
+	~WavWriter()
+	{
+		if (!f)
+		{
+			return;
+		}
+		// patch chunk sizes, the 18 byte fmt chunk puts the data chunk size at offset 42
+		uint32_t dataSize = frames * channels * 4;
+		uint32_t riffSize = 38 + dataSize;
+		std::fseek(f, 4, SEEK_SET);
+		std::fwrite(&riffSize, 4, 1, f);
+		std::fseek(f, 42, SEEK_SET);
+		std::fwrite(&dataSize, 4, 1, f);
+		std::fclose(f);
+	}
+
+	void writeHeader(uint32_t sampleRate)
+	{
+		uint32_t u32;
+		uint16_t u16;
+		std::fwrite("RIFF\0\0\0\0WAVEfmt ", 1, 16, f);
+		u32 = 18;
+		std::fwrite(&u32, 4, 1, f);
+		u16 = 3; // IEEE float
+		std::fwrite(&u16, 2, 1, f);
+		u16 = channels;
+		std::fwrite(&u16, 2, 1, f);
+		std::fwrite(&sampleRate, 4, 1, f);
+		u32 = sampleRate * channels * 4;
+		std::fwrite(&u32, 4, 1, f);
+		u16 = channels * 4;
+		std::fwrite(&u16, 2, 1, f);
+		u16 = 32;
+		std::fwrite(&u16, 2, 1, f);
+		u16 = 0;
+		std::fwrite(&u16, 2, 1, f);
+		std::fwrite("data\0\0\0\0", 1, 8, f);
+	}
+
+	void write(const float* frame)
+	{
+		if (f)
+		{
+			std::fwrite(frame, 4, channels, f);
+			frames++;
+		}
+	}
+};
+
+
+struct Result {
+	double nsPerSample;
+	int voices;
+	OutputStats stats;
+};
+
+/** Renders Options::seconds of audio after a short warm-up and measures the time spent in process() */
+static Result render(Runner& runner, const Options& options, int voices, std::function<void(Runner&, int64_t)> driveInputs, std::vector<int> outputIds, const std::string& wavName)
+{
+	const int64_t warmupFrames = runner.sampleRate * 0.2f;
+	const int64_t frames = runner.sampleRate * options.seconds;
+
+	for (int64_t i = 0; i < warmupFrames; i++)
+	{
+		driveInputs(runner, runner.frame);
+		runner.process();
+	}
+
+	// first pass: timing only
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int64_t i = 0; i < frames; i++)
+	{
+		driveInputs(runner, runner.frame);
+		runner.process();
+	}
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+	Result result;
+	result.nsPerSample = std::chrono::duration<double, std::nano>(end - start).count() / frames;
+	result.voices = voices;
+
+	// second, shorter pass: output statistics and optional wav file, not timed
+	std::unique_ptr<WavWriter> wav;
+	if (!options.wavDirectory.empty())
+	{
+		wav.reset(new WavWriter(options.wavDirectory + "/" + wavName + ".wav", outputIds.size(), runner.sampleRate));
+	}
+	std::vector<float> frame(outputIds.size());
+	for (int64_t i = 0; i < frames; i++)
+	{
+		driveInputs(runner, runner.frame);
+		runner.process();
+		for (size_t o = 0; o < outputIds.size(); o++)
+		{
+			Output& output = runner.module->outputs[outputIds[o]];
+			// sum of all channels, like a mixer would do
+			frame[o] = output.getVoltageSum();
+			result.stats.add(frame[o]);
+		}
+		if (wav)
+		{
+			wav->write(frame.data());
+		}
+	}
+
+	return result;
+}
+
+static void printHeader(const std::string& suite)
+{
+	std::printf("\n%-12s %-44s %10s %12s %12s %9s %9s\n", suite.c_str(), "configuration", "ns/sample", "ns/voice", "voices/core", "rms", "peak");
+}
+
+static void printResult(const std::string& suite, const std::string& configuration, const Result& result, float sampleRate)
+{
+	double budget = 1e9 / sampleRate;
+	double nsPerVoice = result.nsPerSample / result.voices;
+	std::printf("%-12s %-44s %10.1f %12.1f %12.1f %9.4f %9.4f", suite.c_str(), configuration.c_str(), result.nsPerSample, nsPerVoice, budget / nsPerVoice, result.stats.rms(), result.stats.peak);
+	if (result.stats.nonFinite)
+	{
+		std::printf("  (%lld non-finite samples!)", (long long)result.stats.nonFinite);
+	}
+	std::printf("\n");
+	std::fflush(stdout);
+}
+
+static std::string fileName(std::string s)
+{
+	for (char& c : s)
+	{
+		if (!std::isalnum((unsigned char)c) && c != '-' && c != '_')
+		{
+			c = '_';
+		}
+	}
+	return s;
+}
+
+/** Methods and integrator types to sweep, -1 means "leave the module default" */
+static std::vector<int> orDefault(const std::vector<int>& list)
+{
+	return list.empty() ? std::vector<int>{-1} : list;
+}
+
+static std::string methodIntegratorLabel(int method, int integrator)
+{
+	std::string label;
+	if (method >= 0)
+	{
+		label += " " + methodNames[method];
+	}
+	if (integrator >= 0)
+	{
+		label += " " + integratorNames[integrator];
+	}
+	return label;
+}
+
+/** Polyphonic sawtooth test signal, each channel detuned, 5 V peak */
+static float testSaw(int64_t frame, int channel, float sampleRate)
+{
+	float freq = 110.f * std::pow(2.f, channel * 5.f / 12.f / 4.f);
+	float phase = std::fmod(frame * freq / sampleRate, 1.f);
+	return 10.f * phase - 5.f;
+}
+
+
+static void benchSynth(Model* model, const Options& options)
+{
+	printHeader("synth");
+
+	for (int channels : options.channels)
+	{
+		for (int oversampling : options.oversampling)
+		{
+			for (int method : orDefault(options.methods))
+			{
+				for (int integrator : orDefault(options.integrators))
+				{
+					Runner runner(model, options.sampleRate);
+					if (!runner.loadPreset(options.preset))
+					{
+						return;
+					}
+					// before the oversampling rate, which is only applied on the next processUi()
+					for (const auto& entry : options.synthData)
+					{
+						runner.setData(entry.first.c_str(), json_loads(entry.second.c_str(), 0, nullptr));
+					}
+					runner.setData("oversamplingRate", json_integer(oversampling));
+					if (method >= 0)
+					{
+						runner.setData("filterMethod", json_integer(method));
+					}
+					if (integrator >= 0)
+					{
+						runner.setData("filterIntegratorType", json_integer(integrator));
+					}
+
+					int vOct = runner.findInput("V/Oct");
+					int gate = runner.findInput("Gate");
+					int velocity = runner.findInput("Velocity");
+					runner.module->inputs[vOct].channels = channels;
+					runner.module->inputs[gate].channels = channels;
+					runner.module->inputs[velocity].channels = channels;
+
+					int notes = options.notes > 0 ? std::min(options.notes, channels) : channels;
+					auto drive = [=](Runner& r, int64_t frame) {
+						for (int c = 0; c < channels; c++)
+						{
+							// a cluster of notes, each voice retriggered every 0.5 s, staggered
+							int64_t period = r.sampleRate / 2;
+							int64_t pos = (frame + c * period / 16) % period;
+							r.module->inputs[vOct].voltages[c] = (c * 7 % 24) / 12.f - 1.f;
+							r.module->inputs[gate].voltages[c] = c < notes && pos < period * 4 / 5 ? 10.f : 0.f;
+							r.module->inputs[velocity].voltages[c] = 10.f - (c % 4);
+						}
+					};
+
+					std::string configuration = string::f("%2d ch, %2dx", channels, oversampling) + methodIntegratorLabel(method, integrator);
+					if (notes < channels)
+					{
+						configuration += string::f(", %d notes", notes);
+					}
+					for (const auto& entry : options.synthData)
+					{
+						configuration += string::f(", %s %s", entry.first.c_str(), entry.second.c_str());
+					}
+					Result result = render(runner, options, channels, drive, {runner.findOutput("Left/Mono"), runner.findOutput("Right")}, fileName("synth " + configuration));
+					printResult("synth", configuration, result, options.sampleRate);
+				}
+			}
+		}
+	}
+}
+
+static void benchFilter(Model* model, const Options& options)
+{
+	printHeader("filter");
+
+	// mode -1 leaves the module default
+	std::vector<int> modes = options.filterModes;
+	std::vector<std::string> modeLabels;
+	{
+		Runner runner(model, options.sampleRate);
+		modeLabels = runner.getParamLabels("Mode");
+	}
+	if (modes.empty())
+	{
+		modes.push_back(-1);
+	}
+	else if (modes[0] < 0)
+	{
+		modes.clear();
+		for (size_t i = 0; i < modeLabels.size(); i++)
+		{
+			modes.push_back(i);
+		}
+	}
+
+	for (int mode : modes)
+	{
+		for (int channels : options.channels)
+		{
+			for (int oversampling : options.oversampling)
+			{
+				for (int method : orDefault(options.methods))
+				{
+					for (int integrator : orDefault(options.integrators))
+					{
+						Runner runner(model, options.sampleRate);
+						if (mode >= 0)
+						{
+							runner.setParam("Mode", mode);
+						}
+						runner.setParam("Cutoff frequency", 0.5f);
+						runner.setParam("Resonance", 0.5f);
+						runner.setData("oversamplingRate", json_integer(oversampling));
+						if (method >= 0)
+						{
+							runner.setData("method", json_integer(method));
+						}
+						if (integrator >= 0)
+						{
+							runner.setData("integratorType", json_integer(integrator));
+						}
+
+						int in = runner.findInput("Audio");
+						runner.module->inputs[in].channels = channels;
+
+						auto drive = [=](Runner& r, int64_t frame) {
+							for (int c = 0; c < channels; c++)
+							{
+								r.module->inputs[in].voltages[c] = testSaw(frame, c, r.sampleRate);
+							}
+						};
+
+						std::string configuration = string::f("%2d ch, %2dx", channels, oversampling) + methodIntegratorLabel(method, integrator);
+						if (mode >= 0 && mode < (int)modeLabels.size())
+						{
+							configuration = string::f("%2d ", mode) + modeLabels[mode].substr(0, 24) + ", " + configuration;
+						}
+						Result result = render(runner, options, channels, drive, {runner.findOutput("Filtered")}, fileName("filter " + configuration));
+						printResult("filter", configuration, result, options.sampleRate);
+					}
+				}
+			}
+		}
+	}
+}
+
+static void benchOscillators(Model* model, const Options& options)
+{
+	printHeader("oscillators");
+
+	for (int channels : options.channels)
+	{
+		for (int oversampling : options.oversampling)
+		{
+			Runner runner(model, options.sampleRate);
+			runner.setParam("Oscillator 1 volume", 0.5f);
+			runner.setParam("Oscillator 1 shape", 0.3f);
+			runner.setParam("Oscillator 2 shape", -0.5f);
+			runner.setData("oversamplingRate", json_integer(oversampling));
+
+			int vOct1 = runner.findInput("Oscillator 1 V/Oct");
+			int vOct2 = runner.findInput("Oscillator 2 V/Oct");
+			runner.module->inputs[vOct1].channels = channels;
+			runner.module->inputs[vOct2].channels = channels;
+
+			auto drive = [=](Runner& r, int64_t frame) {
+				for (int c = 0; c < channels; c++)
+				{
+					r.module->inputs[vOct1].voltages[c] = (c * 7 % 24) / 12.f - 1.f;
+					r.module->inputs[vOct2].voltages[c] = (c * 7 % 24) / 12.f - 0.99f;
+				}
+			};
+
+			std::string configuration = string::f("%2d ch, %2dx", channels, oversampling);
+			Result result = render(runner, options, channels, drive, {runner.findOutput("Mix")}, fileName("oscillators " + configuration));
+			printResult("oscillators", configuration, result, options.sampleRate);
+		}
+	}
+}
+
+static void benchModMatrix(Model* model, const Options& options)
+{
+	printHeader("modmatrix");
+
+	for (int channels : options.channels)
+	{
+		for (int reduction : {1, 16})
+		{
+			Runner runner(model, options.sampleRate);
+			runner.setData("sampleRateReduction", json_integer(reduction));
+
+			// all 12 inputs to all 16 mixes
+			std::vector<int> ins;
+			for (int i = 0; i < 12; i++)
+			{
+				ins.push_back(runner.findInput("Signal " + std::to_string(i + 1)));
+				runner.module->inputs[ins.back()].channels = channels;
+				for (int j = 0; j < 16; j++)
+				{
+					runner.setParam("Input " + std::to_string(i + 1) + " to Mix " + std::to_string(j + 1), ((i * 7 + j * 3) % 11) / 10.f - 0.5f);
+				}
+			}
+
+			// a table lookup with a different phase per input and channel, testSaw() for all inputs would take longer than the module
+			int period = runner.sampleRate / 110.f;
+			std::vector<float> saw(2 * period);
+			for (int n = 0; n < 2 * period; n++)
+			{
+				saw[n] = 10.f * (n % period) / period - 5.f;
+			}
+
+			std::vector<int> phases;
+			for (size_t i = 0; i < ins.size(); i++)
+			{
+				for (int c = 0; c < channels; c++)
+				{
+					phases.push_back((i * 37 + c * 11) % period);
+				}
+			}
+
+			auto drive = [=](Runner& r, int64_t frame) {
+				const float* wave = saw.data() + frame % period;
+				const int* phase = phases.data();
+				for (size_t i = 0; i < ins.size(); i++)
+				{
+					for (int c = 0; c < channels; c++)
+					{
+						r.module->inputs[ins[i]].voltages[c] = wave[*phase++];
+					}
+				}
+			};
+
+			std::string configuration = string::f("%2d ch, 12 x 16, 1/%d rate", channels, reduction);
+			Result result = render(runner, options, channels, drive, {runner.findOutput("Mix 1"), runner.findOutput("Mix 16")}, fileName("modmatrix " + configuration));
+			printResult("modmatrix", configuration, result, options.sampleRate);
+		}
+	}
+}
+
+static void benchDelay(Model* model, const Options& options)
+{
+	printHeader("delay");
+
+	struct Setting {
+		const char* name;
+		float time;
+		float bbdSize;
+		bool tape;
+	};
+	const Setting settings[] = {
+		{"chorus, 4096 buckets", 0.15f, 12.f, false},
+		{"echo, 4096 buckets", 0.75f, 12.f, false},
+		{"echo, 16384 buckets", 0.9f, 14.f, false},
+		{"tape echo, 65536 buckets", 0.4f, 12.f, true},
+	};
+
+	for (const Setting& setting : settings)
+	{
+		Runner runner(model, options.sampleRate);
+		runner.setParam("Delay time", setting.time);
+		runner.setParam("BBD delay line size", setting.bbdSize);
+		runner.setData("tape", json_boolean(setting.tape));
+
+		int inL = runner.findInput("Left / Mono");
+		int inR = runner.findInput("Right");
+		runner.module->inputs[inL].channels = 1;
+		runner.module->inputs[inR].channels = 1;
+
+		auto drive = [=](Runner& r, int64_t frame) {
+			// short bursts, so that the echoes are audible in the rendered file
+			bool on = frame % (int64_t)r.sampleRate < r.sampleRate / 10;
+			r.module->inputs[inL].voltages[0] = on ? testSaw(frame, 0, r.sampleRate) : 0.f;
+			r.module->inputs[inR].voltages[0] = on ? testSaw(frame, 3, r.sampleRate) : 0.f;
+		};
+
+		Result result = render(runner, options, 1, drive, {runner.findOutput("Left"), runner.findOutput("Right")}, fileName(std::string("delay ") + setting.name));
+		printResult("delay", setting.name, result, options.sampleRate);
+	}
+
+	// one stereo delay per channel, e.g. a chorus per voice
+	for (int channels : options.channels)
+	{
+		Runner runner(model, options.sampleRate);
+		runner.setParam("Delay time", 0.15f);
+		runner.setParam("BBD delay line size", 12.f);
+		runner.setParam("R wet signal = - L wet signal (Chorus mode)", 1.f);
+		runner.setData("polyphonic", json_true());
+
+		int inL = runner.findInput("Left / Mono");
+		runner.module->inputs[inL].channels = channels;
+
+		auto drive = [=](Runner& r, int64_t frame) {
+			bool on = frame % (int64_t)r.sampleRate < r.sampleRate / 10;
+			for (int c = 0; c < channels; c++)
+			{
+				r.module->inputs[inL].voltages[c] = on ? testSaw(frame, c, r.sampleRate) : 0.f;
+			}
+		};
+
+		std::string configuration = string::f("chorus, 4096 buckets, %2d ch poly", channels);
+		Result result = render(runner, options, channels, drive, {runner.findOutput("Left"), runner.findOutput("Right")}, fileName("delay " + configuration));
+		printResult("delay", configuration, result, options.sampleRate);
+	}
+}
+
+
+/** FilterBlock on its own, without the module around it, to compare the filter implementations */
+static void benchFilterBlock(const Options& options)
+{
+	printHeader("filterblock");
+
+	std::vector<std::string> modeLabels = musx::FilterBlock::getModeLabels();
+	std::vector<int> modes = options.filterModes;
+	if (modes.empty() || modes[0] < 0)
+	{
+		modes.clear();
+		for (size_t i = 0; i < modeLabels.size(); i++)
+		{
+			modes.push_back(i);
+		}
+	}
+	std::vector<int> methods = options.methods.empty() ? std::vector<int>{0, 1, 2} : options.methods;
+	std::vector<int> integrators = options.integrators.empty() ? std::vector<int>{(int)musx::IntegratorType::Transistor_tanh} : options.integrators;
+
+	for (int mode : modes)
+	{
+		for (int oversampling : options.oversampling)
+		{
+			for (int method : methods)
+			{
+				for (int integrator : integrators)
+				{
+					musx::FilterBlock filterBlock;
+					filterBlock.setMode(mode);
+					filterBlock.setMethod((musx::Method)method);
+					filterBlock.setIntegratorType((musx::IntegratorType)integrator);
+
+					const float_4 dt = 1.f / (options.sampleRate * oversampling);
+					filterBlock.setSampleTime(dt[0]);
+					filterBlock.updateDelayLine();
+					const int64_t frames = options.sampleRate * options.seconds;
+					std::vector<float_4> buffer(oversampling);
+					Result result;
+					result.voices = 4;
+
+					// test signals are computed up front, so that only the filter is timed
+					std::vector<float_4> input(frames * oversampling);
+					std::vector<float_4> cutoff(frames);
+					for (int64_t frame = 0; frame < frames; frame++)
+					{
+						// slow cutoff sweep, so that the filters do not run at a fixed point
+						cutoff[frame] = 200.f + 2000.f * (1.f + std::sin(frame * 2.f * M_PI / options.sampleRate));
+						for (int i = 0; i < oversampling; i++)
+						{
+							for (int c = 0; c < 4; c++)
+							{
+								input[frame * oversampling + i][c] = testSaw(frame * oversampling + i, c, options.sampleRate * oversampling);
+							}
+						}
+					}
+
+					auto renderBlock = [&](int64_t frame) {
+						filterBlock.setCutoffFrequencyAndResonance(cutoff[frame], 2.5f);
+						std::copy(&input[frame * oversampling], &input[frame * oversampling] + oversampling, buffer.begin());
+						filterBlock.processBlock(buffer.data(), dt, oversampling);
+					};
+
+					for (int64_t frame = 0; frame < frames / 10; frame++)
+					{
+						renderBlock(frame);
+					}
+
+					std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+					for (int64_t frame = 0; frame < frames; frame++)
+					{
+						renderBlock(frame);
+						// the last sample of each block is what a decimator would mostly depend on
+						result.stats.add(buffer[oversampling - 1][0]);
+					}
+					std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+					result.nsPerSample = std::chrono::duration<double, std::nano>(end - start).count() / frames;
+
+					std::string configuration = string::f("%2d ", mode) + modeLabels[mode].substr(0, 24) + string::f(", %2dx", oversampling) + methodIntegratorLabel(method, integrator);
+					printResult("filterblock", configuration, result, options.sampleRate);
+				}
+			}
+		}
+	}
+}
+
+
+/** The exponential kernels on their own: time per float_4 call and max. error against std::exp2 in cents */
+static void benchExp(const Options& options)
+{
+	std::printf("\n%-12s %-44s %10s %12s\n", "exp", "function", "ns/call", "max cents");
+
+	// pitch and cutoff range in V/Oct
+	const int size = 4096;
+	std::vector<float_4> input(size);
+	for (int i = 0; i < size; i++)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			input[i][c] = -10.f + 20.f * (i * 4 + c) / (size * 4 - 1);
+		}
+	}
+
+	// plain loops, so the kernels are inlined like at their call sites
+	std::vector<std::pair<std::string, int>> kernels = {
+		{"musx::fastExp2", 0},
+		{"dsp::exp2_taylor5", 1},
+		{"simd::exp", 2},
+	};
+
+	for (const auto& kernel : kernels)
+	{
+		auto run = [&](std::vector<float_4>& output) {
+			switch (kernel.second)
+			{
+			case 0:
+				for (int i = 0; i < size; i++)
+				{
+					output[i] = musx::fastExp2(input[i]);
+				}
+				break;
+			case 1:
+				for (int i = 0; i < size; i++)
+				{
+					output[i] = dsp::exp2_taylor5(input[i]);
+				}
+				break;
+			default:
+				for (int i = 0; i < size; i++)
+				{
+					output[i] = simd::exp(input[i] * float(M_LN2));
+				}
+			}
+		};
+
+		std::vector<float_4> output(size);
+		int64_t repetitions = std::max<int64_t>(1, options.seconds * 1e9 / size / 10.);
+		float_4 sum = 0.f;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int64_t r = 0; r < repetitions; r++)
+		{
+			run(output);
+			sum += output[r % size];
+		}
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		double nsPerCall = std::chrono::duration<double, std::nano>(end - start).count() / repetitions / size;
+		// keeps the loop from being optimized away
+		volatile float sink = sum[0];
+		(void)sink;
+
+		double maxCents = 0.;
+		for (int i = 0; i < size; i++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				double cents = 1200. * std::log2(output[i][c] / std::exp2((double)input[i][c]));
+				maxCents = std::max(maxCents, std::fabs(cents));
+			}
+		}
+
+		std::printf("%-12s %-44s %10.2f %12.6f\n", "exp", kernel.first.c_str(), nsPerCall, maxCents);
+		std::fflush(stdout);
+	}
+}
+
+
+/** ns per output sample of a decimator cascade, float_4 or mono float, on noise */
+template <typename T>
+static double timeDecimator(const Options& options, int oversampling, bool iir)
+{
+	musx::HalfBandDecimatorCascade<T> decimator;
+	decimator.setIIR(iir);
+
+	// noise is computed up front, so that only the decimator is timed
+	const int64_t frames = options.sampleRate * options.seconds;
+	const int blockFrames = 32;
+	std::vector<T> noise(blockFrames * oversampling);
+	for (T& x : noise)
+	{
+		x = T(random::uniform()) - 0.5f;
+	}
+	std::vector<T> output(blockFrames);
+	T check = 0.f;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int64_t frame = 0; frame < frames; frame += blockFrames)
+	{
+		decimator.processBlock(noise.data(), output.data(), oversampling, blockFrames);
+		check += output[0];
+	}
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	// keeps the loop from being optimized away
+	volatile float sink = *(float*)&check;
+	(void)sink;
+	return std::chrono::duration<double, std::nano>(end - start).count() / frames;
+}
+
+/**
+ * The decimator cascade on its own, linear phase FIR against low latency IIR stages:
+ * time per output sample, group delay at DC, the worst alias from k * fs +- [5..20] kHz, and the level at 20 kHz
+ */
+static void benchDecimator(const Options& options)
+{
+	std::printf("\n%-12s %-44s %10s %10s %12s %12s %12s\n", "decimator", "configuration", "ns/sample", "ns/mono", "delay", "alias dB", "20 kHz dB");
+
+	const float_4 testFrequencies = {5000.f, 10000.f, 15000.f, 20000.f};
+	const int settleFrames = 1024;
+	const int measureFrames = 4096;
+
+	for (int oversampling : options.oversampling)
+	{
+		if (oversampling < 2)
+		{
+			continue;
+		}
+
+		for (int iir = 0; iir < 2; iir++)
+		{
+			musx::HalfBandDecimatorCascade<float_4> decimator;
+			decimator.setIIR(iir);
+
+			// amplitude of the output, for a sine per lane at frequency f
+			auto measure = [&](float_4 f) {
+				decimator.reset();
+				std::vector<float_4> input(oversampling);
+				float_4 sum = 0.f;
+				for (int frame = 0; frame < settleFrames + measureFrames; frame++)
+				{
+					for (int i = 0; i < oversampling; i++)
+					{
+						for (int c = 0; c < 4; c++)
+						{
+							double t = (double)(frame * oversampling + i) / (options.sampleRate * oversampling);
+							input[i][c] = std::sin(2. * M_PI * f[c] * t);
+						}
+					}
+					float_4 y;
+					decimator.processBlock(input.data(), &y, oversampling, 1);
+					if (frame >= settleFrames)
+					{
+						sum += y * y;
+					}
+				}
+				return simd::sqrt(2.f * sum / measureFrames);
+			};
+
+			// everything that folds into 5..20 kHz, up to the oversampled Nyquist frequency
+			float worstAlias = 0.f;
+			for (int k = 1; k <= oversampling / 2; k++)
+			{
+				for (float sign : {-1.f, 1.f})
+				{
+					float_4 f = k * options.sampleRate + sign * testFrequencies;
+					if (simd::movemask(f >= 0.5f * options.sampleRate * oversampling))
+					{
+						continue;
+					}
+					float_4 amplitude = measure(f);
+					for (int c = 0; c < 4; c++)
+					{
+						worstAlias = std::max(worstAlias, amplitude[c]);
+					}
+				}
+			}
+			float passband = measure(testFrequencies)[3];
+
+			// impulse response, its centroid is the group delay at DC
+			decimator.reset();
+			std::vector<float_4> impulse(oversampling, 0.f);
+			impulse[0] = 1.f;
+			double moment = 0.;
+			double area = 0.;
+			for (int frame = 0; frame < settleFrames; frame++)
+			{
+				float_4 y;
+				decimator.processBlock(impulse.data(), &y, oversampling, 1);
+				impulse[0] = 0.f;
+				moment += frame * y[0];
+				area += y[0];
+			}
+
+			double nsPerSample = timeDecimator<float_4>(options, oversampling, iir);
+			double nsPerMonoSample = timeDecimator<float>(options, oversampling, iir);
+
+			std::string configuration = string::f("%2dx, ", oversampling) + (iir ? "IIR" : "FIR");
+			std::printf("%-12s %-44s %10.2f %10.2f %12.2f %12.1f %12.3f\n", "decimator", configuration.c_str(), nsPerSample, nsPerMonoSample, moment / area,
+				20.f * std::log10(worstAlias), 20.f * std::log10(passband));
+			std::fflush(stdout);
+		}
+	}
+}
+
+
+static std::vector<std::string> split(const std::string& s)
+{
+	std::vector<std::string> parts;
+	std::stringstream ss(s);
+	std::string part;
+	while (std::getline(ss, part, ','))
+	{
+		parts.push_back(part);
+	}
+	return parts;
+}
+
+static std::vector<int> parseInts(const std::string& s)
+{
+	std::vector<int> values;
+	for (const std::string& part : split(s))
+	{
+		values.push_back(std::atoi(part.c_str()));
+	}
+	return values;
+}
+
+static std::vector<int> parseNames(const std::string& s, const std::vector<std::string>& names)
+{
+	std::vector<int> values;
+	for (const std::string& part : split(s))
+	{
+		if (part == "all")
+		{
+			values.clear();
+			for (size_t i = 0; i < names.size(); i++)
+			{
+				values.push_back(i);
+			}
+			return values;
+		}
+		auto it = std::find(names.begin(), names.end(), part);
+		if (it == names.end())
+		{
+			std::fprintf(stderr, "unknown value \"%s\"\n", part.c_str());
+			std::exit(1);
+		}
+		values.push_back(it - names.begin());
+	}
+	return values;
+}
+
+static void usage()
+{
+	std::printf(
+		"Usage: bench [options] [suite ...]\n"
+		"\n"
+		"Renders the modules headless and reports the cost per sample.\n"
+		"Suites: synth, filter, oscillators, delay (default), modmatrix, filterblock,\n"
+		"which times FilterBlock alone for every mode and method, exp,\n"
+		"which compares the exponential kernels, and decimator, which compares\n"
+		"the FIR and IIR decimators for every oversampling rate above 1\n"
+		"\n"
+		"Options:\n"
+		"  --seconds <s>           length of each timed render (default 2)\n"
+		"  --samplerate <Hz>       host sample rate (default 48000)\n"
+		"  --channels <list>       polyphony, e.g. 1,4,16\n"
+		"  --oversampling <list>   oversampling rates, e.g. 1,2,4,8,16\n"
+		"  --method <list>         ODE solvers: euler, rk2, rk4 or all\n"
+		"  --integrator <list>     linear, ota_tanh, ota_alt, transistor_tanh, transistor_alt or all\n"
+		"  --filter-modes <list>   Filter module modes by number, e.g. 8,12, or all\n"
+		"  --notes <n>             synth: only the first n voices get gates (default all)\n"
+		"  --set <key>=<value>     synth: set a patch setting, e.g. blockSize=64 or voiceSleep=false\n"
+		"  --preset <file>         Synth preset (default presets/Synth/template.vcvm)\n"
+		"  --wav <dir>             write the rendered output of every run into <dir>\n"
+		"\n"
+		"voices/core is the number of voices one core could render in real time.\n");
+}
+
+} // namespace bench
+} // namespace musx
+
+
+int main(int argc, char* argv[])
+{
+	using namespace musx::bench;
+
+	Options options;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		auto next = [&]() -> std::string {
+			if (i + 1 >= argc)
+			{
+				std::fprintf(stderr, "%s needs a value\n", arg.c_str());
+				std::exit(1);
+			}
+			return argv[++i];
+		};
+
+		if (arg == "--help" || arg == "-h")
+		{
+			usage();
+			return 0;
+		}
+		else if (arg == "--seconds")
+		{
+			options.seconds = std::atof(next().c_str());
+		}
+		else if (arg == "--samplerate")
+		{
+			options.sampleRate = std::atof(next().c_str());
+		}
+		else if (arg == "--channels")
+		{
+			options.channels = parseInts(next());
+		}
+		else if (arg == "--oversampling")
+		{
+			options.oversampling = parseInts(next());
+		}
+		else if (arg == "--method")
+		{
+			options.methods = parseNames(next(), methodNames);
+		}
+		else if (arg == "--integrator")
+		{
+			options.integrators = parseNames(next(), integratorNames);
+		}
+		else if (arg == "--filter-modes")
+		{
+			std::string value = next();
+			options.filterModes = value == "all" ? std::vector<int>{-1} : parseInts(value);
+		}
+		else if (arg == "--notes")
+		{
+			options.notes = std::atoi(next().c_str());
+		}
+		else if (arg == "--set")
+		{
+			std::string value = next();
+			size_t pos = value.find('=');
+			if (pos == std::string::npos)
+			{
+				std::fprintf(stderr, "--set needs <key>=<value>\n");
+				return 1;
+			}
+			// numbers and true/false, e.g. blockSize=64 or voiceSleep=false
+			json_t* valueJ = json_loads(value.c_str() + pos + 1, 0, nullptr);
+			if (!valueJ)
+			{
+				std::fprintf(stderr, "--set needs a JSON value, e.g. 64 or true: %s\n", value.c_str());
+				return 1;
+			}
+			json_decref(valueJ);
+			options.synthData.push_back({value.substr(0, pos), value.substr(pos + 1)});
+		}
+		else if (arg == "--preset")
+		{
+			options.preset = next();
+		}
+		else if (arg == "--wav")
+		{
+			options.wavDirectory = next();
+		}
+		else if (!arg.empty() && arg[0] == '-')
+		{
+			std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+			usage();
+			return 1;
+		}
+		else
+		{
+			options.suites.push_back(arg);
+		}
+	}
+	if (options.suites.empty())
+	{
+		options.suites = {"synth", "filter", "oscillators", "delay"};
+	}
+
+	// like the Rack engine threads: flush denormals to zero
+	_MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+	_MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+
+	// deterministic noise and drift, so that renders can be compared
+	random::init();
+
+	Plugin* plugin = new Plugin;
+	init(plugin);
+
+	for (const std::string& suite : options.suites)
+	{
+		if (suite == "synth")
+		{
+			benchSynth(plugin->getModel("Synth"), options);
+		}
+		else if (suite == "filter")
+		{
+			benchFilter(plugin->getModel("Filter"), options);
+		}
+		else if (suite == "oscillators")
+		{
+			benchOscillators(plugin->getModel("Oscillators"), options);
+		}
+		else if (suite == "delay")
+		{
+			benchDelay(plugin->getModel("Delay"), options);
+		}
+		else if (suite == "modmatrix")
+		{
+			benchModMatrix(plugin->getModel("ModMatrix"), options);
+		}
+		else if (suite == "filterblock")
+		{
+			benchFilterBlock(options);
+		}
+		else if (suite == "exp")
+		{
+			benchExp(options);
+		}
+		else if (suite == "decimator")
+		{
+			benchDecimator(options);
+		}
+		else
+		{
+			std::fprintf(stderr, "unknown suite %s\n", suite.c_str());
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,384 @@
+#pragma once
+
+// Stand-in for the subset of jansson used by the musx modules
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+struct json_t {
+	enum Type {
+		OBJECT,
+		ARRAY,
+		STRING,
+		INTEGER,
+		REAL,
+		TRUE,
+		FALSE,
+		NULLVALUE
+	};
+
+	Type type = NULLVALUE;
+	std::map<std::string, json_t*> object;
+	std::vector<json_t*> array;
+	std::string string;
+	int64_t integer = 0;
+	double real = 0.0;
+
+	explicit json_t(Type type) : type(type) {}
+
+	~json_t()
+	{
+		for (auto& it : object)
+		{
+			delete it.second;
+		}
+		for (json_t* j : array)
+		{
+			delete j;
+		}
+	}
+};
+
+typedef int64_t json_int_t;
+
+inline json_t* json_object() { return new json_t(json_t::OBJECT); }
+inline json_t* json_array() { return new json_t(json_t::ARRAY); }
+inline json_t* json_true() { return new json_t(json_t::TRUE); }
+inline json_t* json_false() { return new json_t(json_t::FALSE); }
+inline json_t* json_null() { return new json_t(json_t::NULLVALUE); }
+inline json_t* json_boolean(bool value) { return new json_t(value ? json_t::TRUE : json_t::FALSE); }
+
+inline json_t* json_integer(json_int_t value)
+{
+	json_t* j = new json_t(json_t::INTEGER);
+	j->integer = value;
+	return j;
+}
+
+inline json_t* json_real(double value)
+{
+	json_t* j = new json_t(json_t::REAL);
+	j->real = value;
+	return j;
+}
+
+inline json_t* json_string(const char* value)
+{
+	json_t* j = new json_t(json_t::STRING);
+	j->string = value;
+	return j;
+}
+
+inline void json_decref(json_t* json)
+{
+	delete json;
+}
+
+inline bool json_is_object(const json_t* json) { return json && json->type == json_t::OBJECT; }
+inline bool json_is_array(const json_t* json) { return json && json->type == json_t::ARRAY; }
+inline bool json_is_true(const json_t* json) { return json && json->type == json_t::TRUE; }
+inline bool json_is_integer(const json_t* json) { return json && json->type == json_t::INTEGER; }
+inline bool json_is_real(const json_t* json) { return json && json->type == json_t::REAL; }
+inline bool json_is_number(const json_t* json) { return json_is_integer(json) || json_is_real(json); }
+
+inline bool json_boolean_value(const json_t* json) { return json_is_true(json); }
+inline json_int_t json_integer_value(const json_t* json) { return json_is_integer(json) ? json->integer : 0; }
+inline double json_real_value(const json_t* json) { return json_is_real(json) ? json->real : 0.0; }
+inline const char* json_string_value(const json_t* json) { return json && json->type == json_t::STRING ? json->string.c_str() : nullptr; }
+
+inline double json_number_value(const json_t* json)
+{
+	if (json_is_integer(json))
+	{
+		return json->integer;
+	}
+	return json_real_value(json);
+}
+
+inline json_t* json_object_get(const json_t* object, const char* key)
+{
+	if (!json_is_object(object))
+	{
+		return nullptr;
+	}
+	auto it = object->object.find(key);
+	return it == object->object.end() ? nullptr : it->second;
+}
+
+inline int json_object_set_new(json_t* object, const char* key, json_t* value)
+{
+	if (!json_is_object(object))
+	{
+		delete value;
+		return -1;
+	}
+	auto it = object->object.find(key);
+	if (it != object->object.end())
+	{
+		delete it->second;
+	}
+	object->object[key] = value;
+	return 0;
+}
+
+inline size_t json_array_size(const json_t* array)
+{
+	return json_is_array(array) ? array->array.size() : 0;
+}
+
+inline json_t* json_array_get(const json_t* array, size_t index)
+{
+	if (!json_is_array(array) || index >= array->array.size())
+	{
+		return nullptr;
+	}
+	return array->array[index];
+}
+
+inline int json_array_append_new(json_t* array, json_t* value)
+{
+	if (!json_is_array(array))
+	{
+		delete value;
+		return -1;
+	}
+	array->array.push_back(value);
+	return 0;
+}
+
+inline int json_array_insert_new(json_t* array, size_t index, json_t* value)
+{
+	if (!json_is_array(array) || index > array->array.size())
+	{
+		delete value;
+		return -1;
+	}
+	array->array.insert(array->array.begin() + index, value);
+	return 0;
+}
+
+
+// Minimal recursive descent parser, enough to read .vcvm presets
+
+struct json_error_t {
+	int line = 0;
+	char text[160] = {};
+};
+
+namespace jsonstub {
+
+inline void skipSpace(const char*& p)
+{
+	while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
+	{
+		p++;
+	}
+}
+
+inline json_t* parseValue(const char*& p);
+
+inline bool parseString(const char*& p, std::string& out)
+{
+	if (*p != '"')
+	{
+		return false;
+	}
+	p++;
+	while (*p && *p != '"')
+	{
+		if (*p == '\\')
+		{
+			p++;
+			switch (*p)
+			{
+				case 'n': out += '\n'; break;
+				case 't': out += '\t'; break;
+				case 'r': out += '\r'; break;
+				case 'b': out += '\b'; break;
+				case 'f': out += '\f'; break;
+				case 'u': out += '?'; p += 4; break;
+				default: out += *p; break;
+			}
+			if (*p)
+			{
+				p++;
+			}
+			continue;
+		}
+		out += *p++;
+	}
+	if (*p != '"')
+	{
+		return false;
+	}
+	p++;
+	return true;
+}
+
+inline json_t* parseValue(const char*& p)
+{
+	skipSpace(p);
+	if (*p == '{')
+	{
+		p++;
+		json_t* object = json_object();
+		skipSpace(p);
+		if (*p == '}')
+		{
+			p++;
+			return object;
+		}
+		while (true)
+		{
+			skipSpace(p);
+			std::string key;
+			if (!parseString(p, key))
+			{
+				json_decref(object);
+				return nullptr;
+			}
+			skipSpace(p);
+			if (*p++ != ':')
+			{
+				json_decref(object);
+				return nullptr;
+			}
+			json_t* value = parseValue(p);
+			if (!value)
+			{
+				json_decref(object);
+				return nullptr;
+			}
+			json_object_set_new(object, key.c_str(), value);
+			skipSpace(p);
+			if (*p == ',')
+			{
+				p++;
+				continue;
+			}
+			if (*p == '}')
+			{
+				p++;
+				return object;
+			}
+			json_decref(object);
+			return nullptr;
+		}
+	}
+	if (*p == '[')
+	{
+		p++;
+		json_t* array = json_array();
+		skipSpace(p);
+		if (*p == ']')
+		{
+			p++;
+			return array;
+		}
+		while (true)
+		{
+			json_t* value = parseValue(p);
+			if (!value)
+			{
+				json_decref(array);
+				return nullptr;
+			}
+			json_array_append_new(array, value);
+			skipSpace(p);
+			if (*p == ',')
+			{
+				p++;
+				continue;
+			}
+			if (*p == ']')
+			{
+				p++;
+				return array;
+			}
+			json_decref(array);
+			return nullptr;
+		}
+	}
+	if (*p == '"')
+	{
+		std::string s;
+		if (!parseString(p, s))
+		{
+			return nullptr;
+		}
+		return json_string(s.c_str());
+	}
+	if (!std::strncmp(p, "true", 4))
+	{
+		p += 4;
+		return json_true();
+	}
+	if (!std::strncmp(p, "false", 5))
+	{
+		p += 5;
+		return json_false();
+	}
+	if (!std::strncmp(p, "null", 4))
+	{
+		p += 4;
+		return json_null();
+	}
+
+	const char* start = p;
+	bool isReal = false;
+	if (*p == '-')
+	{
+		p++;
+	}
+	while ((*p >= '0' && *p <= '9') || *p == '.' || *p == 'e' || *p == 'E' || *p == '+' || *p == '-')
+	{
+		isReal |= (*p == '.' || *p == 'e' || *p == 'E');
+		p++;
+	}
+	if (p == start)
+	{
+		return nullptr;
+	}
+	std::string number(start, p);
+	return isReal ? json_real(std::strtod(number.c_str(), nullptr)) : json_integer(std::strtoll(number.c_str(), nullptr, 10));
+}
+
+} // namespace jsonstub
+
+inline json_t* json_loads(const char* input, size_t flags, json_error_t* error)
+{
+	const char* p = input;
+	json_t* root = jsonstub::parseValue(p);
+	if (!root && error)
+	{
+		std::snprintf(error->text, sizeof(error->text), "parse error at offset %d", (int)(p - input));
+	}
+	return root;
+}
+
+inline json_t* json_load_file(const char* path, size_t flags, json_error_t* error)
+{
+	FILE* f = std::fopen(path, "rb");
+	if (!f)
+	{
+		if (error)
+		{
+			std::snprintf(error->text, sizeof(error->text), "cannot open %s", path);
+		}
+		return nullptr;
+	}
+	std::string content;
+	char buf[4096];
+	size_t n;
+	while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0)
+	{
+		content.append(buf, n);
+	}
+	std::fclose(f);
+	return json_loads(content.c_str(), flags, error);
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+// Rack has a top level math.hpp, everything lives in rack.hpp here
+#include "rack.hpp"
@@ -0,0 +1,1049 @@
+#pragma once
+
+// Minimal stand-in for the parts of the VCV Rack SDK used by the musx modules.
+//
+// This lets the bench harness compile the module sources without the Rack SDK
+// and drive Module::process() headless. The DSP relevant parts (simd vectors,
+// dsp helpers, ports, params) follow the Rack v2 implementation, everything
+// UI related is an empty shell that only has to compile.
+
+#include <pmmintrin.h>
+#include <smmintrin.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "simd.hpp"
+#include "json.hpp"
+
+namespace rack {
+
+/** Same as Rack's `string::f()`. */
+namespace string {
+inline std::string f(const char* format, ...) __attribute__((format(printf, 1, 2)));
+inline std::string f(const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	char buf[1024];
+	vsnprintf(buf, sizeof(buf), format, args);
+	va_end(args);
+	return buf;
+}
+}
+
+namespace math {
+
+inline int clamp(int x, int a, int b)
+{
+	return std::max(std::min(x, b), a);
+}
+
+inline float clamp(float x, float a = 0.f, float b = 1.f)
+{
+	return std::fmax(std::fmin(x, b), a);
+}
+
+inline float rescale(float x, float xMin, float xMax, float yMin, float yMax)
+{
+	return yMin + (x - xMin) / (xMax - xMin) * (yMax - yMin);
+}
+
+template <typename T>
+T crossfade(T a, T b, T p)
+{
+	return a + (b - a) * p;
+}
+
+template <typename T>
+T sgn(T x)
+{
+	return x > 0 ? 1 : (x < 0 ? -1 : 0);
+}
+
+inline bool isNear(float a, float b, float epsilon = 1e-6f)
+{
+	return std::fabs(a - b) <= epsilon;
+}
+
+inline int eucMod(int a, int b)
+{
+	int mod = a % b;
+	if (mod < 0)
+	{
+		mod += b;
+	}
+	return mod;
+}
+
+inline bool isPow2(int n)
+{
+	return n > 0 && (n & (n - 1)) == 0;
+}
+
+struct Vec {
+	float x = 0.f;
+	float y = 0.f;
+
+	Vec() {}
+	Vec(float xy) : x(xy), y(xy) {}
+	Vec(float x, float y) : x(x), y(y) {}
+
+	Vec plus(Vec b) const { return Vec(x + b.x, y + b.y); }
+	Vec minus(Vec b) const { return Vec(x - b.x, y - b.y); }
+	Vec mult(float s) const { return Vec(x * s, y * s); }
+	Vec div(float s) const { return Vec(x / s, y / s); }
+};
+
+struct Rect {
+	Vec pos;
+	Vec size;
+};
+
+} // namespace math
+
+
+namespace dsp {
+
+static const float FREQ_C4 = 261.6256f;
+
+template <typename T>
+T approxExp2Floor(T x, T* xf);
+
+template <>
+inline simd::float_4 approxExp2Floor(simd::float_4 x, simd::float_4* xf)
+{
+	simd::int32_4 xi = x;
+	if (xf)
+	{
+		*xf = x - simd::float_4(xi);
+	}
+	simd::int32_4 y = (xi + 127) << 23;
+	return simd::float_4::cast(y);
+}
+
+template <>
+inline float approxExp2Floor(float x, float* xf)
+{
+	int32_t xi = x;
+	if (xf)
+	{
+		*xf = x - xi;
+	}
+	int32_t y = (xi + 127) << 23;
+	float r;
+	std::memcpy(&r, &y, sizeof(r));
+	return r;
+}
+
+template <typename T>
+T approxExp2_taylor5(T x)
+{
+	T xf;
+	T yi = approxExp2Floor(x, &xf);
+	T yf = 1.f
+		+ 0.69315169353961f * xf
+		+ 0.2401595597575f * xf * xf
+		+ 0.055817908652f * xf * xf * xf
+		+ 0.008991698010f * xf * xf * xf * xf
+		+ 0.001879100722f * xf * xf * xf * xf * xf;
+	return yi * yf;
+}
+
+template <typename T>
+T exp2_taylor5(T x)
+{
+	return approxExp2_taylor5(x);
+}
+
+struct ClockDivider {
+	uint32_t clock = 0;
+	uint32_t division = 1;
+
+	void reset() { clock = 0; }
+	void setDivision(uint32_t division) { this->division = division; }
+	uint32_t getDivision() { return division; }
+	uint32_t getClock() { return clock; }
+
+	bool process()
+	{
+		clock++;
+		if (clock >= division)
+		{
+			clock = 0;
+			return true;
+		}
+		return false;
+	}
+};
+
+template <typename T = float>
+struct TSchmittTrigger {
+	T state;
+
+	TSchmittTrigger() { reset(); }
+	void reset() { state = T::mask(); }
+
+	T process(T in, T lowThreshold = 0.f, T highThreshold = 1.f)
+	{
+		T on = (in >= highThreshold);
+		T off = (in <= lowThreshold);
+		T triggered = ~state & on;
+		state = on | (state & ~off);
+		return triggered;
+	}
+
+	T isHigh() { return state; }
+};
+
+template <>
+struct TSchmittTrigger<float> {
+	bool state = true;
+
+	void reset() { state = true; }
+
+	bool process(float in, float lowThreshold = 0.f, float highThreshold = 1.f)
+	{
+		if (state)
+		{
+			if (in <= lowThreshold)
+			{
+				state = false;
+			}
+		}
+		else if (in >= highThreshold)
+		{
+			state = true;
+			return true;
+		}
+		return false;
+	}
+
+	bool isHigh() { return state; }
+};
+
+typedef TSchmittTrigger<> SchmittTrigger;
+
+struct PulseGenerator {
+	float remaining = 0.f;
+
+	void reset() { remaining = 0.f; }
+	bool process(float deltaTime)
+	{
+		if (remaining > 0.f)
+		{
+			remaining -= deltaTime;
+			return true;
+		}
+		return false;
+	}
+	void trigger(float duration = 1e-3f)
+	{
+		remaining = std::max(remaining, duration);
+	}
+};
+
+template <typename T = float>
+struct TBiquadFilter {
+	enum Type {
+		LOWPASS_1POLE,
+		HIGHPASS_1POLE,
+		LOWPASS,
+		HIGHPASS,
+		LOWSHELF,
+		HIGHSHELF,
+		BANDPASS,
+		PEAK,
+		NOTCH,
+		NUM_TYPES
+	};
+
+	float b[3] = {};
+	float a[2] = {};
+	T x[2] = {};
+	T y[2] = {};
+
+	TBiquadFilter()
+	{
+		reset();
+		setParameters(LOWPASS, 0.f, 0.f, 1.f);
+	}
+
+	void reset()
+	{
+		x[0] = x[1] = y[0] = y[1] = 0.f;
+	}
+
+	T process(T in)
+	{
+		T out = b[0] * in + b[1] * x[0] + b[2] * x[1] - a[0] * y[0] - a[1] * y[1];
+		x[1] = x[0];
+		x[0] = in;
+		y[1] = y[0];
+		y[0] = out;
+		return out;
+	}
+
+	/** f is the cutoff frequency normalized by the sample rate */
+	void setParameters(Type type, float f, float Q, float V)
+	{
+		float K = std::tan(M_PI * f);
+		switch (type)
+		{
+			case LOWPASS_1POLE: {
+				a[0] = -std::exp(-2.f * M_PI * f);
+				a[1] = 0.f;
+				b[0] = 1.f + a[0];
+				b[1] = 0.f;
+				b[2] = 0.f;
+			} break;
+			case HIGHPASS_1POLE: {
+				a[0] = std::exp(-2.f * M_PI * (0.5f - f));
+				a[1] = 0.f;
+				b[0] = 1.f - a[0];
+				b[1] = 0.f;
+				b[2] = 0.f;
+			} break;
+			case LOWPASS: {
+				float norm = 1.f / (1.f + K / Q + K * K);
+				b[0] = K * K * norm;
+				b[1] = 2.f * b[0];
+				b[2] = b[0];
+				a[0] = 2.f * (K * K - 1.f) * norm;
+				a[1] = (1.f - K / Q + K * K) * norm;
+			} break;
+			case HIGHPASS: {
+				float norm = 1.f / (1.f + K / Q + K * K);
+				b[0] = norm;
+				b[1] = -2.f * b[0];
+				b[2] = b[0];
+				a[0] = 2.f * (K * K - 1.f) * norm;
+				a[1] = (1.f - K / Q + K * K) * norm;
+			} break;
+			case BANDPASS: {
+				float norm = 1.f / (1.f + K / Q + K * K);
+				b[0] = K / Q * norm;
+				b[1] = 0.f;
+				b[2] = -b[0];
+				a[0] = 2.f * (K * K - 1.f) * norm;
+				a[1] = (1.f - K / Q + K * K) * norm;
+			} break;
+			case NOTCH: {
+				float norm = 1.f / (1.f + K / Q + K * K);
+				b[0] = (1.f + K * K) * norm;
+				b[1] = 2.f * (K * K - 1.f) * norm;
+				b[2] = b[0];
+				a[0] = b[1];
+				a[1] = (1.f - K / Q + K * K) * norm;
+			} break;
+			default: {
+				// shelves and peak are not used by musx, pass through
+				b[0] = V;
+				b[1] = b[2] = 0.f;
+				a[0] = a[1] = 0.f;
+			} break;
+		}
+	}
+};
+
+typedef TBiquadFilter<> BiquadFilter;
+
+} // namespace dsp
+
+
+namespace random {
+
+struct Xoroshiro128Plus {
+	uint64_t state[2] = {};
+
+	void seed(uint64_t s0, uint64_t s1)
+	{
+		state[0] = s0;
+		state[1] = s1;
+		// A bad seed will give a bad first result, so shift the state
+		operator()();
+	}
+
+	static uint64_t rotl(uint64_t x, int k)
+	{
+		return (x << k) | (x >> (64 - k));
+	}
+
+	uint64_t operator()()
+	{
+		uint64_t s0 = state[0];
+		uint64_t s1 = state[1];
+		uint64_t result = s0 + s1;
+		s1 ^= s0;
+		state[0] = rotl(s0, 24) ^ s1 ^ (s1 << 16);
+		state[1] = rotl(s1, 37);
+		return result;
+	}
+};
+
+inline Xoroshiro128Plus& local()
+{
+	static thread_local Xoroshiro128Plus rng;
+	return rng;
+}
+
+inline void init()
+{
+	local().seed(0x3243f6a8885a308dULL, 0x13198a2e03707344ULL);
+}
+
+template <typename T>
+T get()
+{
+	return local()();
+}
+
+template <>
+inline uint32_t get()
+{
+	return local()() >> 32;
+}
+
+template <>
+inline float get()
+{
+	// 24 random bits, [0, 1)
+	return (get<uint32_t>() >> 8) * 5.9604645e-08f;
+}
+
+inline uint32_t u32() { return get<uint32_t>(); }
+inline uint64_t u64() { return get<uint64_t>(); }
+inline float uniform() { return get<float>(); }
+
+inline float normal()
+{
+	// Box-Muller transform
+	float radius = std::sqrt(-2.f * std::log(1.f - get<float>()));
+	float theta = 2.f * M_PI * get<float>();
+	return radius * std::sin(theta);
+}
+
+} // namespace random
+
+
+namespace plugin {
+
+struct Model;
+
+struct Plugin {
+	std::string slug = "MUS-X";
+	std::string path = ".";
+	std::vector<Model*> models;
+
+	void addModel(Model* model);
+	Model* getModel(const std::string& slug);
+};
+
+} // namespace plugin
+
+
+namespace asset {
+
+inline std::string plugin(plugin::Plugin* p, std::string filename)
+{
+	return (p ? p->path : std::string(".")) + "/" + filename;
+}
+
+inline std::string system(std::string filename)
+{
+	return filename;
+}
+
+inline std::string user(std::string filename)
+{
+	return filename;
+}
+
+} // namespace asset
+
+
+namespace engine {
+
+struct Module;
+
+struct Param {
+	float value = 0.f;
+
+	float getValue() { return value; }
+	void setValue(float value) { this->value = value; }
+};
+
+struct Port {
+	union {
+		float voltages[16] = {};
+		float value;
+	};
+	union {
+		uint8_t channels = 0;
+		uint8_t active;
+	};
+
+	float getVoltage(int channel = 0) { return voltages[channel]; }
+	void setVoltage(float voltage, int channel = 0) { voltages[channel] = voltage; }
+
+	float getPolyVoltage(int channel)
+	{
+		return isMonophonic() ? getVoltage(0) : getVoltage(channel);
+	}
+
+	float getNormalVoltage(float normalVoltage, int channel = 0)
+	{
+		return isConnected() ? getVoltage(channel) : normalVoltage;
+	}
+
+	float getNormalPolyVoltage(float normalVoltage, int channel)
+	{
+		return isConnected() ? getPolyVoltage(channel) : normalVoltage;
+	}
+
+	float* getVoltages(int firstChannel = 0) { return &voltages[firstChannel]; }
+
+	template <typename T>
+	T getVoltageSimd(int firstChannel)
+	{
+		return T::load(&voltages[firstChannel]);
+	}
+
+	template <typename T>
+	T getPolyVoltageSimd(int firstChannel)
+	{
+		return isMonophonic() ? getVoltage(0) : getVoltageSimd<T>(firstChannel);
+	}
+
+	template <typename T>
+	T getNormalVoltageSimd(T normalVoltage, int firstChannel)
+	{
+		return isConnected() ? getVoltageSimd<T>(firstChannel) : normalVoltage;
+	}
+
+	template <typename T>
+	T getNormalPolyVoltageSimd(T normalVoltage, int firstChannel)
+	{
+		return isConnected() ? getPolyVoltageSimd<T>(firstChannel) : normalVoltage;
+	}
+
+	template <typename T>
+	void setVoltageSimd(T voltage, int firstChannel)
+	{
+		voltage.store(&voltages[firstChannel]);
+	}
+
+	float getVoltageSum()
+	{
+		float sum = 0.f;
+		for (int c = 0; c < channels; c++)
+		{
+			sum += voltages[c];
+		}
+		return sum;
+	}
+
+	float getVoltageRMS()
+	{
+		if (channels == 0)
+		{
+			return 0.f;
+		}
+		float sum = 0.f;
+		for (int c = 0; c < channels; c++)
+		{
+			sum += voltages[c] * voltages[c];
+		}
+		return std::sqrt(sum);
+	}
+
+	void setChannels(int channels)
+	{
+		// If disconnected, keep the number of channels at 0.
+		if (this->channels == 0)
+		{
+			return;
+		}
+		for (int c = std::max(channels, 0); c < std::min((int)this->channels, 16); c++)
+		{
+			voltages[c] = 0.f;
+		}
+		if (channels == 0)
+		{
+			channels = 1;
+		}
+		this->channels = channels;
+	}
+
+	int getChannels() { return channels; }
+	bool isConnected() { return channels > 0; }
+	bool isMonophonic() { return channels == 1; }
+	bool isPolyphonic() { return channels > 1; }
+	void clearVoltages()
+	{
+		for (float& v : voltages)
+		{
+			v = 0.f;
+		}
+	}
+};
+
+struct Output : Port {};
+struct Input : Port {};
+
+struct Light {
+	float value = 0.f;
+
+	void setBrightness(float brightness) { value = brightness; }
+	float getBrightness() { return value; }
+	void setBrightnessSmooth(float brightness, float deltaTime, float lambda = 30.f)
+	{
+		value += (brightness - value) * std::fmin(lambda * deltaTime, 1.f);
+	}
+	void setSmoothBrightness(float brightness, float deltaTime)
+	{
+		setBrightnessSmooth(brightness, deltaTime);
+	}
+};
+
+struct ParamQuantity {
+	Module* module = nullptr;
+	int paramId = -1;
+	float minValue = 0.f;
+	float maxValue = 1.f;
+	float defaultValue = 0.f;
+	std::string name;
+	std::string unit;
+	float displayBase = 0.f;
+	float displayMultiplier = 1.f;
+	float displayOffset = 0.f;
+	int displayPrecision = 5;
+	std::string description;
+	bool resetEnabled = true;
+	bool randomizeEnabled = true;
+	bool smoothEnabled = false;
+	bool snapEnabled = false;
+
+	virtual ~ParamQuantity() {}
+
+	Param* getParam();
+	// inline, so they are no key functions and the vtable is only emitted where a quantity is created
+	inline virtual void setValue(float value);
+	inline virtual float getValue();
+	virtual float getMinValue() { return minValue; }
+	virtual float getMaxValue() { return maxValue; }
+	virtual float getDefaultValue() { return defaultValue; }
+	virtual float getDisplayValue() { return getValue() * displayMultiplier + displayOffset; }
+	virtual void setDisplayValue(float displayValue) { setValue((displayValue - displayOffset) / displayMultiplier); }
+	virtual std::string getDisplayValueString() { return string::f("%g", getDisplayValue()); }
+	virtual void setDisplayValueString(std::string s) { setDisplayValue(std::atof(s.c_str())); }
+	virtual std::string getLabel() { return name; }
+	virtual std::string getUnit() { return unit; }
+	virtual std::string getString() { return getLabel() + ": " + getDisplayValueString() + getUnit(); }
+	virtual std::string getDescription() { return description; }
+	virtual void reset() { setValue(getDefaultValue()); }
+	virtual void randomize() {}
+	float getScaledValue() { return rescale(getValue(), getMinValue(), getMaxValue(), 0.f, 1.f); }
+	void setScaledValue(float scaledValue) { setValue(rescale(scaledValue, 0.f, 1.f, getMinValue(), getMaxValue())); }
+
+	static float rescale(float x, float xMin, float xMax, float yMin, float yMax)
+	{
+		return math::rescale(x, xMin, xMax, yMin, yMax);
+	}
+};
+
+struct SwitchQuantity : ParamQuantity {
+	std::vector<std::string> labels;
+
+	std::string getDisplayValueString() override
+	{
+		int index = (int)std::floor(getValue() - getMinValue());
+		if (index < 0 || index >= (int)labels.size())
+		{
+			return ParamQuantity::getDisplayValueString();
+		}
+		return labels[index];
+	}
+};
+
+struct PortInfo {
+	Module* module = nullptr;
+	int type = 0;
+	int portId = -1;
+	std::string name;
+	std::string description;
+
+	virtual ~PortInfo() {}
+	virtual std::string getName() { return name; }
+	virtual std::string getDescription() { return description; }
+};
+
+struct LightInfo {
+	Module* module = nullptr;
+	int lightId = -1;
+	std::string name;
+	std::string description;
+
+	virtual ~LightInfo() {}
+};
+
+struct BypassRoute {
+	int inputId = -1;
+	int outputId = -1;
+};
+
+struct Module {
+	plugin::Model* model = nullptr;
+	int64_t id = -1;
+
+	std::vector<Param> params;
+	std::vector<Input> inputs;
+	std::vector<Output> outputs;
+	std::vector<Light> lights;
+
+	std::vector<ParamQuantity*> paramQuantities;
+	std::vector<PortInfo*> inputInfos;
+	std::vector<PortInfo*> outputInfos;
+	std::vector<LightInfo*> lightInfos;
+	std::vector<BypassRoute> bypassRoutes;
+
+	struct Expander {
+		int64_t moduleId = -1;
+		Module* module = nullptr;
+		void* producerMessage = nullptr;
+		void* consumerMessage = nullptr;
+		bool messageFlipRequested = false;
+
+		void requestMessageFlip() { messageFlipRequested = true; }
+	};
+
+	Expander leftExpander;
+	Expander rightExpander;
+
+	Module() {}
+
+	virtual ~Module()
+	{
+		for (ParamQuantity* pq : paramQuantities)
+		{
+			delete pq;
+		}
+		for (PortInfo* info : inputInfos)
+		{
+			delete info;
+		}
+		for (PortInfo* info : outputInfos)
+		{
+			delete info;
+		}
+		for (LightInfo* info : lightInfos)
+		{
+			delete info;
+		}
+	}
+
+	void config(int numParams, int numInputs, int numOutputs, int numLights = 0)
+	{
+		params.resize(numParams);
+		inputs.resize(numInputs);
+		outputs.resize(numOutputs);
+		lights.resize(numLights);
+		paramQuantities.resize(numParams);
+		for (int i = 0; i < numParams; i++)
+		{
+			configParam(i, 0.f, 1.f, 0.f);
+		}
+		inputInfos.resize(numInputs);
+		for (int i = 0; i < numInputs; i++)
+		{
+			configInput(i);
+		}
+		outputInfos.resize(numOutputs);
+		for (int i = 0; i < numOutputs; i++)
+		{
+			configOutput(i);
+		}
+		lightInfos.resize(numLights);
+	}
+
+	template <class TParamQuantity = ParamQuantity>
+	TParamQuantity* configParam(int paramId, float minValue, float maxValue, float defaultValue, std::string name = "", std::string unit = "", float displayBase = 0.f, float displayMultiplier = 1.f, float displayOffset = 0.f)
+	{
+		if (paramQuantities[paramId])
+		{
+			delete paramQuantities[paramId];
+		}
+		TParamQuantity* q = new TParamQuantity;
+		q->ParamQuantity::module = this;
+		q->ParamQuantity::paramId = paramId;
+		q->ParamQuantity::minValue = minValue;
+		q->ParamQuantity::maxValue = maxValue;
+		q->ParamQuantity::defaultValue = defaultValue;
+		q->ParamQuantity::name = name;
+		q->ParamQuantity::unit = unit;
+		q->ParamQuantity::displayBase = displayBase;
+		q->ParamQuantity::displayMultiplier = displayMultiplier;
+		q->ParamQuantity::displayOffset = displayOffset;
+		paramQuantities[paramId] = q;
+		params[paramId].value = q->getDefaultValue();
+		return q;
+	}
+
+	template <class TSwitchQuantity = SwitchQuantity>
+	TSwitchQuantity* configSwitch(int paramId, float minValue, float maxValue, float defaultValue, std::string name = "", std::vector<std::string> labels = {})
+	{
+		TSwitchQuantity* sq = configParam<TSwitchQuantity>(paramId, minValue, maxValue, defaultValue, name);
+		sq->snapEnabled = true;
+		sq->smoothEnabled = false;
+		sq->labels = labels;
+		return sq;
+	}
+
+	template <class TSwitchQuantity = SwitchQuantity>
+	TSwitchQuantity* configButton(int paramId, std::string name = "")
+	{
+		TSwitchQuantity* sq = configParam<TSwitchQuantity>(paramId, 0.f, 1.f, 0.f, name);
+		sq->randomizeEnabled = false;
+		sq->snapEnabled = true;
+		return sq;
+	}
+
+	template <class TPortInfo = PortInfo>
+	TPortInfo* configInput(int portId, std::string name = "")
+	{
+		if (inputInfos[portId])
+		{
+			delete inputInfos[portId];
+		}
+		TPortInfo* info = new TPortInfo;
+		info->module = this;
+		info->portId = portId;
+		info->name = name;
+		inputInfos[portId] = info;
+		return info;
+	}
+
+	template <class TPortInfo = PortInfo>
+	TPortInfo* configOutput(int portId, std::string name = "")
+	{
+		if (outputInfos[portId])
+		{
+			delete outputInfos[portId];
+		}
+		TPortInfo* info = new TPortInfo;
+		info->module = this;
+		info->portId = portId;
+		info->name = name;
+		outputInfos[portId] = info;
+		return info;
+	}
+
+	template <class TLightInfo = LightInfo>
+	TLightInfo* configLight(int lightId, std::string name = "")
+	{
+		if (lightInfos[lightId])
+		{
+			delete lightInfos[lightId];
+		}
+		TLightInfo* info = new TLightInfo;
+		info->module = this;
+		info->lightId = lightId;
+		info->name = name;
+		lightInfos[lightId] = info;
+		return info;
+	}
+
+	void configBypass(int inputId, int outputId)
+	{
+		BypassRoute br;
+		br.inputId = inputId;
+		br.outputId = outputId;
+		bypassRoutes.push_back(br);
+	}
+
+	plugin::Model* getModel() { return model; }
+	int64_t getId() { return id; }
+	int getNumParams() { return params.size(); }
+	Param& getParam(int index) { return params[index]; }
+	int getNumInputs() { return inputs.size(); }
+	Input& getInput(int index) { return inputs[index]; }
+	int getNumOutputs() { return outputs.size(); }
+	Output& getOutput(int index) { return outputs[index]; }
+	int getNumLights() { return lights.size(); }
+	Light& getLight(int index) { return lights[index]; }
+	ParamQuantity* getParamQuantity(int index) { return paramQuantities[index]; }
+	PortInfo* getInputInfo(int index) { return inputInfos[index]; }
+	PortInfo* getOutputInfo(int index) { return outputInfos[index]; }
+	LightInfo* getLightInfo(int index) { return lightInfos[index]; }
+	Expander& getLeftExpander() { return leftExpander; }
+	Expander& getRightExpander() { return rightExpander; }
+
+	struct ProcessArgs {
+		float sampleRate;
+		float sampleTime;
+		int64_t frame;
+	};
+
+	virtual void process(const ProcessArgs& args) {}
+	virtual void step() {}
+
+	virtual json_t* toJson() { return nullptr; }
+	virtual void fromJson(json_t* rootJ) {}
+	virtual json_t* dataToJson() { return nullptr; }
+	virtual void dataFromJson(json_t* rootJ) {}
+
+	struct AddEvent {};
+	struct RemoveEvent {};
+	struct EnableEvent {};
+	struct DisableEvent {};
+	struct PortChangeEvent {
+		bool connecting;
+		int type;
+		int portId;
+	};
+	struct SampleRateChangeEvent {
+		float sampleRate;
+		float sampleTime;
+	};
+	struct ExpanderChangeEvent {
+		uint8_t side;
+	};
+	struct BypassEvent {};
+	struct UnBypassEvent {};
+	struct ResetEvent {};
+	struct RandomizeEvent {};
+	struct SaveEvent {};
+	struct SetMasterEvent {};
+	struct UnsetMasterEvent {};
+
+	virtual void onAdd(const AddEvent& e) { onAdd(); }
+	virtual void onRemove(const RemoveEvent& e) { onRemove(); }
+	virtual void onEnable(const EnableEvent& e) {}
+	virtual void onDisable(const DisableEvent& e) {}
+	virtual void onBypass(const BypassEvent& e) {}
+	virtual void onUnBypass(const UnBypassEvent& e) {}
+	virtual void onPortChange(const PortChangeEvent& e) {}
+	virtual void onSampleRateChange(const SampleRateChangeEvent& e) { onSampleRateChange(); }
+	virtual void onExpanderChange(const ExpanderChangeEvent& e) {}
+	virtual void onReset(const ResetEvent& e)
+	{
+		for (ParamQuantity* pq : paramQuantities)
+		{
+			if (pq && pq->resetEnabled)
+			{
+				pq->reset();
+			}
+		}
+		onReset();
+	}
+	virtual void onRandomize(const RandomizeEvent& e) { onRandomize(); }
+	virtual void onSave(const SaveEvent& e) {}
+
+	virtual void onAdd() {}
+	virtual void onRemove() {}
+	virtual void onReset() {}
+	virtual void onRandomize() {}
+	virtual void onSampleRateChange() {}
+};
+
+inline Param* ParamQuantity::getParam()
+{
+	return module ? &module->params[paramId] : nullptr;
+}
+
+inline void ParamQuantity::setValue(float value)
+{
+	if (module)
+	{
+		module->params[paramId].setValue(value);
+	}
+}
+
+inline float ParamQuantity::getValue()
+{
+	return module ? module->params[paramId].getValue() : 0.f;
+}
+
+} // namespace engine
+
+} // namespace rack
+
+#include "widgets.hpp"
+
+namespace rack {
+
+namespace plugin {
+
+struct Model {
+	Plugin* plugin = nullptr;
+	std::string slug;
+
+	virtual ~Model() {}
+	virtual engine::Module* createModule() = 0;
+	virtual app::ModuleWidget* createModuleWidget(engine::Module* m) = 0;
+
+	std::string getFactoryPresetDirectory() { return asset::plugin(plugin, "presets/" + slug); }
+	std::string getUserPresetDirectory() { return asset::user("presets/" + slug); }
+};
+
+inline void Plugin::addModel(Model* model)
+{
+	model->plugin = this;
+	models.push_back(model);
+}
+
+inline Model* Plugin::getModel(const std::string& slug)
+{
+	for (Model* model : models)
+	{
+		if (model->slug == slug)
+		{
+			return model;
+		}
+	}
+	return nullptr;
+}
+
+} // namespace plugin
+
+template <class TModule, class TModuleWidget>
+plugin::Model* createModel(std::string slug)
+{
+	struct TModel : plugin::Model {
+		engine::Module* createModule() override
+		{
+			TModule* m = new TModule;
+			m->model = this;
+			return m;
+		}
+		app::ModuleWidget* createModuleWidget(engine::Module* m) override
+		{
+			return nullptr;
+		}
+	};
+
+	plugin::Model* o = new TModel;
+	o->slug = slug;
+	return o;
+}
+
+using namespace math;
+using namespace engine;
+using namespace plugin;
+using namespace widget;
+using namespace app;
+using namespace ui;
+using namespace componentlibrary;
+
+} // namespace rack
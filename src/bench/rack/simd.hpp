@@ -0,0 +1,568 @@
+#pragma once
+
+// Stand-in for Rack's simd/Vector.hpp and simd/functions.hpp (SSE4 only)
+
+#include <pmmintrin.h>
+#include <smmintrin.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace rack {
+namespace simd {
+
+template <typename T, int N>
+struct Vector;
+
+template <>
+struct Vector<float, 4>;
+template <>
+struct Vector<int32_t, 4>;
+
+template <>
+struct Vector<float, 4> {
+	using type = float;
+	constexpr static int size = 4;
+
+	union {
+		__m128 v;
+		float s[4];
+	};
+
+	Vector() = default;
+	Vector(__m128 v) : v(v) {}
+	Vector(float x) { v = _mm_set1_ps(x); }
+	Vector(float x1, float x2, float x3, float x4) { v = _mm_setr_ps(x1, x2, x3, x4); }
+
+	static Vector zero() { return Vector(_mm_setzero_ps()); }
+	static Vector mask() { return Vector(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_setzero_si128(), _mm_setzero_si128()))); }
+	static Vector load(const float* x) { return Vector(_mm_loadu_ps(x)); }
+	void store(float* x) { _mm_storeu_ps(x, v); }
+
+	float& operator[](int i) { return s[i]; }
+	const float& operator[](int i) const { return s[i]; }
+
+	Vector(Vector<int32_t, 4> a);
+	static Vector cast(Vector<int32_t, 4> a);
+};
+
+template <>
+struct Vector<int32_t, 4> {
+	using type = int32_t;
+	constexpr static int size = 4;
+
+	union {
+		__m128i v;
+		int32_t s[4];
+	};
+
+	Vector() = default;
+	Vector(__m128i v) : v(v) {}
+	Vector(int32_t x) { v = _mm_set1_epi32(x); }
+	Vector(int32_t x1, int32_t x2, int32_t x3, int32_t x4) { v = _mm_setr_epi32(x1, x2, x3, x4); }
+
+	static Vector zero() { return Vector(_mm_setzero_si128()); }
+	static Vector mask() { return Vector(_mm_cmpeq_epi32(_mm_setzero_si128(), _mm_setzero_si128())); }
+	static Vector load(const int32_t* x) { return Vector(_mm_loadu_si128((const __m128i*)x)); }
+	void store(int32_t* x) { _mm_storeu_si128((__m128i*)x, v); }
+
+	int32_t& operator[](int i) { return s[i]; }
+	const int32_t& operator[](int i) const { return s[i]; }
+
+	Vector(Vector<float, 4> a);
+	static Vector cast(Vector<float, 4> a);
+};
+
+inline Vector<float, 4>::Vector(Vector<int32_t, 4> a)
+{
+	this->v = _mm_cvtepi32_ps(a.v);
+}
+
+inline Vector<int32_t, 4>::Vector(Vector<float, 4> a)
+{
+	this->v = _mm_cvttps_epi32(a.v);
+}
+
+inline Vector<float, 4> Vector<float, 4>::cast(Vector<int32_t, 4> a)
+{
+	return Vector(_mm_castsi128_ps(a.v));
+}
+
+inline Vector<int32_t, 4> Vector<int32_t, 4>::cast(Vector<float, 4> a)
+{
+	return Vector(_mm_castps_si128(a.v));
+}
+
+typedef Vector<float, 4> float_4;
+typedef Vector<int32_t, 4> int32_4;
+
+
+#define DECLARE_VECTOR_OPERATOR_INFIX(t, s, operator, func) \
+	inline Vector<t, s> operator(const Vector<t, s>& a, const Vector<t, s>& b) \
+	{ \
+		return Vector<t, s>(func(a.v, b.v)); \
+	}
+
+#define DECLARE_VECTOR_OPERATOR_INCREMENT(t, s, operator, opfunc) \
+	inline Vector<t, s>& operator(Vector<t, s>& a, const Vector<t, s>& b) \
+	{ \
+		return a = opfunc(a, b); \
+	}
+
+DECLARE_VECTOR_OPERATOR_INFIX(float, 4, operator+, _mm_add_ps)
+DECLARE_VECTOR_OPERATOR_INFIX(int32_t, 4, operator+, _mm_add_epi32)
+
+DECLARE_VECTOR_OPERATOR_INFIX(float, 4, operator-, _mm_sub_ps)
+DECLARE_VECTOR_OPERATOR_INFIX(int32_t, 4, operator-, _mm_sub_epi32)
+
+DECLARE_VECTOR_OPERATOR_INFIX(float, 4, operator*, _mm_mul_ps)
+DECLARE_VECTOR_OPERATOR_INFIX(float, 4, operator/, _mm_div_ps)
+
+DECLARE_VECTOR_OPERATOR_INFIX(float, 4, operator^, _mm_xor_ps)
+DECLARE_VECTOR_OPERATOR_INFIX(int32_t, 4, operator^, _mm_xor_si128)
+
+DECLARE_VECTOR_OPERATOR_INFIX(float, 4, operator&, _mm_and_ps)
+DECLARE_VECTOR_OPERATOR_INFIX(int32_t, 4, operator&, _mm_and_si128)
+
+DECLARE_VECTOR_OPERATOR_INFIX(float, 4, operator|, _mm_or_ps)
+DECLARE_VECTOR_OPERATOR_INFIX(int32_t, 4, operator|, _mm_or_si128)
+
+DECLARE_VECTOR_OPERATOR_INCREMENT(float, 4, operator+=, operator+)
+DECLARE_VECTOR_OPERATOR_INCREMENT(int32_t, 4, operator+=, operator+)
+DECLARE_VECTOR_OPERATOR_INCREMENT(float, 4, operator-=, operator-)
+DECLARE_VECTOR_OPERATOR_INCREMENT(int32_t, 4, operator-=, operator-)
+DECLARE_VECTOR_OPERATOR_INCREMENT(float, 4, operator*=, operator*)
+DECLARE_VECTOR_OPERATOR_INCREMENT(float, 4, operator/=, operator/)
+DECLARE_VECTOR_OPERATOR_INCREMENT(float, 4, operator^=, operator^)
+DECLARE_VECTOR_OPERATOR_INCREMENT(int32_t, 4, operator^=, operator^)
+DECLARE_VECTOR_OPERATOR_INCREMENT(float, 4, operator&=, operator&)
+DECLARE_VECTOR_OPERATOR_INCREMENT(int32_t, 4, operator&=, operator&)
+DECLARE_VECTOR_OPERATOR_INCREMENT(float, 4, operator|=, operator|)
+DECLARE_VECTOR_OPERATOR_INCREMENT(int32_t, 4, operator|=, operator|)
+
+DECLARE_VECTOR_OPERATOR_INFIX(float, 4, operator==, _mm_cmpeq_ps)
+DECLARE_VECTOR_OPERATOR_INFIX(int32_t, 4, operator==, _mm_cmpeq_epi32)
+
+DECLARE_VECTOR_OPERATOR_INFIX(float, 4, operator>=, _mm_cmpge_ps)
+inline Vector<int32_t, 4> operator>=(const Vector<int32_t, 4>& a, const Vector<int32_t, 4>& b)
+{
+	return Vector<int32_t, 4>(_mm_cmplt_epi32(a.v, b.v)) ^ Vector<int32_t, 4>::mask();
+}
+
+DECLARE_VECTOR_OPERATOR_INFIX(float, 4, operator>, _mm_cmpgt_ps)
+DECLARE_VECTOR_OPERATOR_INFIX(int32_t, 4, operator>, _mm_cmpgt_epi32)
+
+DECLARE_VECTOR_OPERATOR_INFIX(float, 4, operator<=, _mm_cmple_ps)
+inline Vector<int32_t, 4> operator<=(const Vector<int32_t, 4>& a, const Vector<int32_t, 4>& b)
+{
+	return Vector<int32_t, 4>(_mm_cmpgt_epi32(a.v, b.v)) ^ Vector<int32_t, 4>::mask();
+}
+
+DECLARE_VECTOR_OPERATOR_INFIX(float, 4, operator<, _mm_cmplt_ps)
+DECLARE_VECTOR_OPERATOR_INFIX(int32_t, 4, operator<, _mm_cmplt_epi32)
+
+DECLARE_VECTOR_OPERATOR_INFIX(float, 4, operator!=, _mm_cmpneq_ps)
+inline Vector<int32_t, 4> operator!=(const Vector<int32_t, 4>& a, const Vector<int32_t, 4>& b)
+{
+	return Vector<int32_t, 4>(_mm_cmpeq_epi32(a.v, b.v)) ^ Vector<int32_t, 4>::mask();
+}
+
+#undef DECLARE_VECTOR_OPERATOR_INFIX
+#undef DECLARE_VECTOR_OPERATOR_INCREMENT
+
+template <typename T>
+Vector<T, 4> operator+(const Vector<T, 4>& a)
+{
+	return a;
+}
+
+template <typename T>
+Vector<T, 4> operator-(const Vector<T, 4>& a)
+{
+	return 0 - a;
+}
+
+template <typename T>
+Vector<T, 4>& operator++(Vector<T, 4>& a)
+{
+	return a += 1;
+}
+
+template <typename T>
+Vector<T, 4>& operator--(Vector<T, 4>& a)
+{
+	return a -= 1;
+}
+
+template <typename T>
+Vector<T, 4> operator++(Vector<T, 4>& a, int)
+{
+	Vector<T, 4> b = a;
+	++a;
+	return b;
+}
+
+template <typename T>
+Vector<T, 4> operator--(Vector<T, 4>& a, int)
+{
+	Vector<T, 4> b = a;
+	--a;
+	return b;
+}
+
+inline Vector<float, 4> operator~(const Vector<float, 4>& a)
+{
+	return a ^ Vector<float, 4>::mask();
+}
+
+inline Vector<int32_t, 4> operator~(const Vector<int32_t, 4>& a)
+{
+	return a ^ Vector<int32_t, 4>::mask();
+}
+
+inline Vector<int32_t, 4> operator<<(const Vector<int32_t, 4>& a, const int& b)
+{
+	return Vector<int32_t, 4>(_mm_slli_epi32(a.v, b));
+}
+
+inline Vector<int32_t, 4> operator>>(const Vector<int32_t, 4>& a, const int& b)
+{
+	return Vector<int32_t, 4>(_mm_srli_epi32(a.v, b));
+}
+
+
+// functions
+
+inline float_4 fmax(float_4 x, float_4 b)
+{
+	return float_4(_mm_max_ps(x.v, b.v));
+}
+
+inline float_4 fmin(float_4 x, float_4 b)
+{
+	return float_4(_mm_min_ps(x.v, b.v));
+}
+
+inline float_4 sqrt(float_4 x)
+{
+	return float_4(_mm_sqrt_ps(x.v));
+}
+
+inline float_4 rsqrt(float_4 x)
+{
+	return float_4(_mm_rsqrt_ps(x.v));
+}
+
+inline float_4 rcp(float_4 x)
+{
+	return float_4(_mm_rcp_ps(x.v));
+}
+
+inline float_4 abs(float_4 x)
+{
+	return x & float_4::cast(int32_4(0x7fffffff));
+}
+
+inline float_4 fabs(float_4 x)
+{
+	return abs(x);
+}
+
+inline float_4 floor(float_4 a)
+{
+	return float_4(_mm_floor_ps(a.v));
+}
+
+inline float_4 ceil(float_4 a)
+{
+	return float_4(_mm_ceil_ps(a.v));
+}
+
+inline float_4 round(float_4 a)
+{
+	return float_4(_mm_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+}
+
+inline float_4 trunc(float_4 a)
+{
+	return float_4(_mm_round_ps(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+}
+
+inline float_4 fmod(float_4 a, float_4 b)
+{
+	return a - trunc(a / b) * b;
+}
+
+inline float_4 clamp(float_4 x, float_4 a = 0.f, float_4 b = 1.f)
+{
+	return fmin(fmax(x, a), b);
+}
+
+inline float_4 crossfade(float_4 a, float_4 b, float_4 p)
+{
+	return a + (b - a) * p;
+}
+
+inline float_4 sgn(float_4 x)
+{
+	float_4 signbit = x & -0.f;
+	float_4 nonzero = (x != 0.f);
+	return signbit | (nonzero & 1.f);
+}
+
+inline float_4 ifelse(float_4 mask, float_4 a, float_4 b)
+{
+	return float_4(_mm_blendv_ps(b.v, a.v, mask.v));
+}
+
+inline int32_4 ifelse(int32_4 mask, int32_4 a, int32_4 b)
+{
+	return int32_4::cast(ifelse(float_4::cast(mask), float_4::cast(a), float_4::cast(b)));
+}
+
+inline float_4 toFloatBits(float_4 a)
+{
+	return a;
+}
+
+inline float_4 toFloatBits(int32_4 a)
+{
+	return float_4::cast(a);
+}
+
+inline void fromFloatBits(float_4 bits, float_4& out)
+{
+	out = bits;
+}
+
+inline void fromFloatBits(float_4 bits, int32_4& out)
+{
+	out = int32_4::cast(bits);
+}
+
+inline float_4 maskToFloat(float_4 mask)
+{
+	return mask;
+}
+
+inline float_4 maskToFloat(int32_4 mask)
+{
+	return float_4::cast(mask);
+}
+
+template <typename A, typename B>
+struct IfElseResult {
+	typedef float_4 type;
+};
+
+template <typename B>
+struct IfElseResult<int32_4, B> {
+	typedef int32_4 type;
+};
+
+template <typename A>
+struct IfElseResult<A, int32_4> {
+	typedef int32_4 type;
+};
+
+template <>
+struct IfElseResult<int32_4, int32_4> {
+	typedef int32_4 type;
+};
+
+template <typename M>
+struct IsVectorMask {};
+
+template <>
+struct IsVectorMask<float_4> {
+	typedef void type;
+};
+
+template <>
+struct IsVectorMask<int32_4> {
+	typedef void type;
+};
+
+/** Mixed mask / value types, e.g. an int32_4 comparison selecting float_4 values */
+template <typename M, typename A, typename B, typename = typename IsVectorMask<M>::type>
+typename IfElseResult<A, B>::type ifelse(M mask, A a, B b)
+{
+	typedef typename IfElseResult<A, B>::type R;
+	R ra = R(a);
+	R rb = R(b);
+	R result;
+	fromFloatBits(float_4(_mm_blendv_ps(toFloatBits(rb).v, toFloatBits(ra).v, maskToFloat(mask).v)), result);
+	return result;
+}
+
+inline int movemask(float_4 a)
+{
+	return _mm_movemask_ps(a.v);
+}
+
+inline int movemask(int32_4 a)
+{
+	return _mm_movemask_ps(_mm_castsi128_ps(a.v));
+}
+
+/** Cephes style exp as in sse_mathfun, which Rack uses */
+inline float_4 exp(float_4 x)
+{
+	const float_4 one = 1.f;
+	x = fmin(x, 88.3762626647949f);
+	x = fmax(x, -88.3762626647949f);
+
+	// express exp(x) as exp(g + n*log(2))
+	float_4 fx = x * 1.44269504088896341f + 0.5f;
+	float_4 tmp = floor(fx);
+	fx = tmp;
+
+	x = x - tmp * 0.693359375f;
+	x = x - tmp * -2.12194440e-4f;
+
+	float_4 z = x * x;
+	float_4 y = 1.9875691500E-4f;
+	y = y * x + 1.3981999507E-3f;
+	y = y * x + 8.3334519073E-3f;
+	y = y * x + 4.1665795894E-2f;
+	y = y * x + 1.6666665459E-1f;
+	y = y * x + 5.0000001201E-1f;
+	y = y * z + x + one;
+
+	// build 2^n
+	int32_4 emm0 = int32_4(fx) + 0x7f;
+	emm0 = emm0 << 23;
+	return y * float_4::cast(emm0);
+}
+
+/** Cephes style natural log as in sse_mathfun, which Rack uses */
+inline float_4 log(float_4 x)
+{
+	const float_4 one = 1.f;
+	float_4 invalidMask = x <= 0.f;
+
+	// cut off denormalized stuff
+	x = fmax(x, float_4::cast(int32_4(0x00800000)));
+
+	int32_4 emm0 = int32_4(_mm_srli_epi32(int32_4::cast(x).v, 23));
+	// keep only the fractional part
+	x = x & float_4::cast(int32_4(~0x7f800000));
+	x = x | 0.5f;
+
+	emm0 = emm0 - 0x7f;
+	float_4 e = float_4(emm0) + one;
+
+	float_4 mask = x < 0.707106781186547524f;
+	float_4 tmp = x & mask;
+	x = x - one;
+	e = e - (one & mask);
+	x = x + tmp;
+
+	float_4 z = x * x;
+	float_4 y = 7.0376836292E-2f;
+	y = y * x - 1.1514610310E-1f;
+	y = y * x + 1.1676998740E-1f;
+	y = y * x - 1.2420140846E-1f;
+	y = y * x + 1.4249322787E-1f;
+	y = y * x - 1.6668057665E-1f;
+	y = y * x + 2.0000714765E-1f;
+	y = y * x - 2.4999993993E-1f;
+	y = y * x + 3.3333331174E-1f;
+	y = y * x * z;
+
+	y = y + e * -2.12194440e-4f;
+	y = y - z * 0.5f;
+	x = x + y;
+	x = x + e * 0.693359375f;
+	// negative arg will be NAN
+	return x | invalidMask;
+}
+
+inline float_4 pow(float_4 a, float_4 b)
+{
+	return exp(b * log(a));
+}
+
+inline float_4 pow(float a, float_4 b)
+{
+	return exp(b * std::log(a));
+}
+
+template <typename T>
+T pow(T a, int b)
+{
+	// Optimal with `-O3 -funsafe-math-optimizations` when b is known at compile-time
+	T p = 1;
+	for (int i = 1; i <= b; i <<= 1)
+	{
+		if (i & b)
+		{
+			p *= a;
+		}
+		a *= a;
+	}
+	return p;
+}
+
+#define MUSX_BENCH_LANEWISE(name, fn) \
+	inline float_4 name(float_4 x) \
+	{ \
+		return float_4(std::fn(x[0]), std::fn(x[1]), std::fn(x[2]), std::fn(x[3])); \
+	}
+
+MUSX_BENCH_LANEWISE(sin, sin)
+MUSX_BENCH_LANEWISE(cos, cos)
+MUSX_BENCH_LANEWISE(tan, tan)
+MUSX_BENCH_LANEWISE(atan, atan)
+MUSX_BENCH_LANEWISE(log2, log2)
+MUSX_BENCH_LANEWISE(log10, log10)
+MUSX_BENCH_LANEWISE(exp2, exp2)
+
+#undef MUSX_BENCH_LANEWISE
+
+inline float_4 atan2(float_4 x, float_4 y)
+{
+	return float_4(std::atan2(x[0], y[0]), std::atan2(x[1], y[1]), std::atan2(x[2], y[2]), std::atan2(x[3], y[3]));
+}
+
+// scalar versions, as in Rack
+
+using std::fmax;
+using std::fmin;
+using std::sqrt;
+using std::floor;
+using std::ceil;
+using std::round;
+using std::trunc;
+using std::fmod;
+using std::exp;
+using std::log;
+using std::sin;
+using std::cos;
+using std::tan;
+using std::fabs;
+
+inline float clamp(float x, float a = 0.f, float b = 1.f)
+{
+	return std::fmax(std::fmin(x, b), a);
+}
+
+inline float sgn(float x)
+{
+	return x > 0.f ? 1.f : (x < 0.f ? -1.f : 0.f);
+}
+
+template <typename T>
+T ifelse(bool cond, T a, T b)
+{
+	return cond ? a : b;
+}
+
+inline float crossfade(float a, float b, float p)
+{
+	return a + (b - a) * p;
+}
+
+} // namespace simd
+} // namespace rack
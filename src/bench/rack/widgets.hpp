@@ -0,0 +1,566 @@
+#pragma once
+
+// Empty shells for the Rack UI classes used by the musx module widgets.
+// The bench never creates widgets, this only has to compile.
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct NVGcontext;
+
+struct NVGcolor {
+	float r = 0.f;
+	float g = 0.f;
+	float b = 0.f;
+	float a = 1.f;
+};
+
+enum NVGwinding {
+	NVG_CCW = 1,
+	NVG_CW = 2,
+};
+
+enum NVGlineCap {
+	NVG_BUTT,
+	NVG_ROUND,
+	NVG_SQUARE,
+};
+
+enum NVGalign {
+	NVG_ALIGN_LEFT = 1 << 0,
+	NVG_ALIGN_CENTER = 1 << 1,
+	NVG_ALIGN_RIGHT = 1 << 2,
+	NVG_ALIGN_TOP = 1 << 3,
+	NVG_ALIGN_MIDDLE = 1 << 4,
+	NVG_ALIGN_BOTTOM = 1 << 5,
+	NVG_ALIGN_BASELINE = 1 << 6,
+};
+
+inline NVGcolor nvgRGBA(unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+	NVGcolor color;
+	color.r = r / 255.f;
+	color.g = g / 255.f;
+	color.b = b / 255.f;
+	color.a = a / 255.f;
+	return color;
+}
+
+inline NVGcolor nvgRGB(unsigned char r, unsigned char g, unsigned char b)
+{
+	return nvgRGBA(r, g, b, 255);
+}
+
+inline void nvgBeginPath(NVGcontext*) {}
+inline void nvgClosePath(NVGcontext*) {}
+inline void nvgMoveTo(NVGcontext*, float, float) {}
+inline void nvgLineTo(NVGcontext*, float, float) {}
+inline void nvgArc(NVGcontext*, float, float, float, float, float, int) {}
+inline void nvgRect(NVGcontext*, float, float, float, float) {}
+inline void nvgRoundedRect(NVGcontext*, float, float, float, float, float) {}
+inline void nvgCircle(NVGcontext*, float, float, float) {}
+inline void nvgLineCap(NVGcontext*, int) {}
+inline void nvgStrokeWidth(NVGcontext*, float) {}
+inline void nvgStrokeColor(NVGcontext*, NVGcolor) {}
+inline void nvgStroke(NVGcontext*) {}
+inline void nvgFillColor(NVGcontext*, NVGcolor) {}
+inline void nvgFill(NVGcontext*) {}
+inline void nvgFontFaceId(NVGcontext*, int) {}
+inline void nvgFontSize(NVGcontext*, float) {}
+inline void nvgTextAlign(NVGcontext*, int) {}
+inline void nvgTextLetterSpacing(NVGcontext*, float) {}
+inline float nvgText(NVGcontext*, float x, float, const char*, const char*) { return x; }
+inline void nvgSave(NVGcontext*) {}
+inline void nvgRestore(NVGcontext*) {}
+
+namespace rack {
+
+static const NVGcolor SCHEME_BLACK = nvgRGB(0x00, 0x00, 0x00);
+static const NVGcolor SCHEME_WHITE = nvgRGB(0xff, 0xff, 0xff);
+static const NVGcolor SCHEME_RED = nvgRGB(0xed, 0x2c, 0x24);
+static const NVGcolor SCHEME_ORANGE = nvgRGB(0xf2, 0xb1, 0x20);
+static const NVGcolor SCHEME_YELLOW = nvgRGB(0xf9, 0xdf, 0x1c);
+static const NVGcolor SCHEME_GREEN = nvgRGB(0x90, 0xc7, 0x3e);
+static const NVGcolor SCHEME_CYAN = nvgRGB(0x22, 0xe6, 0xef);
+static const NVGcolor SCHEME_BLUE = nvgRGB(0x29, 0xb2, 0xef);
+static const NVGcolor SCHEME_PURPLE = nvgRGB(0xd5, 0x2b, 0xed);
+static const NVGcolor SCHEME_LIGHT_GRAY = nvgRGB(0xe6, 0xe6, 0xe6);
+static const NVGcolor SCHEME_DARK_GRAY = nvgRGB(0x17, 0x17, 0x17);
+
+static const float RACK_GRID_WIDTH = 15;
+static const float RACK_GRID_HEIGHT = 380;
+static const math::Vec RACK_GRID_SIZE = math::Vec(RACK_GRID_WIDTH, RACK_GRID_HEIGHT);
+
+inline math::Vec mm2px(math::Vec mm)
+{
+	return mm.mult(75.f / 25.4f);
+}
+
+struct Font {
+	int handle = -1;
+};
+
+struct Window {
+	std::shared_ptr<Font> loadFont(const std::string& filename)
+	{
+		return std::make_shared<Font>();
+	}
+};
+
+struct Context {
+	Window* window = nullptr;
+};
+
+inline Context* contextGet()
+{
+	static Window window;
+	static Context context;
+	context.window = &window;
+	return &context;
+}
+
+#define APP rack::contextGet()
+
+namespace widget {
+
+struct Widget {
+	math::Rect box;
+	Widget* parent = nullptr;
+	std::vector<Widget*> children;
+	bool visible = true;
+
+	virtual ~Widget()
+	{
+		for (Widget* child : children)
+		{
+			delete child;
+		}
+	}
+
+	struct DrawArgs {
+		NVGcontext* vg = nullptr;
+		math::Rect clipBox;
+	};
+
+	struct ChangeEvent {};
+	struct HoverEvent {};
+	struct ButtonEvent {};
+	struct DragStartEvent {};
+	struct DragEndEvent {};
+	struct DragMoveEvent {};
+
+	virtual void step() {}
+	virtual void draw(const DrawArgs& args) {}
+	virtual void drawLayer(const DrawArgs& args, int layer) {}
+	virtual void onChange(const ChangeEvent& e) {}
+	virtual void onButton(const ButtonEvent& e) {}
+
+	void addChild(Widget* child)
+	{
+		child->parent = this;
+		children.push_back(child);
+	}
+
+	void show() { visible = true; }
+	void hide() { visible = false; }
+	bool isVisible() { return visible; }
+};
+
+struct TransparentWidget : Widget {};
+struct OpaqueWidget : Widget {};
+
+} // namespace widget
+
+namespace event {
+typedef widget::Widget::ChangeEvent Change;
+}
+
+namespace ui {
+
+struct MenuEntry : widget::OpaqueWidget {};
+
+struct Menu : widget::OpaqueWidget {};
+
+struct MenuLabel : MenuEntry {
+	std::string text;
+};
+
+struct MenuSeparator : MenuEntry {};
+
+struct MenuItem : MenuEntry {
+	std::string text;
+	std::string rightText;
+	bool disabled = false;
+
+	virtual Menu* createChildMenu() { return nullptr; }
+};
+
+} // namespace ui
+
+inline ui::MenuLabel* createMenuLabel(std::string text)
+{
+	ui::MenuLabel* label = new ui::MenuLabel;
+	label->text = text;
+	return label;
+}
+
+template <class TMenuItem = ui::MenuItem>
+TMenuItem* createMenuItem(std::string text, std::string rightText = "")
+{
+	TMenuItem* item = new TMenuItem;
+	item->text = text;
+	item->rightText = rightText;
+	return item;
+}
+
+template <class TMenuItem = ui::MenuItem>
+TMenuItem* createMenuItem(std::string text, std::string rightText, std::function<void()> action, bool disabled = false, bool alwaysConsume = false)
+{
+	TMenuItem* item = createMenuItem<TMenuItem>(text, rightText);
+	item->disabled = disabled;
+	return item;
+}
+
+template <class TMenuItem = ui::MenuItem>
+ui::MenuItem* createCheckMenuItem(std::string text, std::string rightText, std::function<bool()> checked, std::function<void()> action, bool disabled = false, bool alwaysConsume = false)
+{
+	return createMenuItem<TMenuItem>(text, rightText, action, disabled, alwaysConsume);
+}
+
+template <class TMenuItem = ui::MenuItem>
+ui::MenuItem* createBoolMenuItem(std::string text, std::string rightText, std::function<bool()> getter, std::function<void(bool state)> setter, bool disabled = false, bool alwaysConsume = false)
+{
+	return createMenuItem<TMenuItem>(text, rightText, nullptr, disabled, alwaysConsume);
+}
+
+template <typename T>
+ui::MenuItem* createBoolPtrMenuItem(std::string text, std::string rightText, T* ptr)
+{
+	return createMenuItem(text, rightText);
+}
+
+template <class TMenuItem = ui::MenuItem>
+ui::MenuItem* createSubmenuItem(std::string text, std::string rightText, std::function<void(ui::Menu* menu)> createMenu, bool disabled = false)
+{
+	return createMenuItem<TMenuItem>(text, rightText, nullptr, disabled);
+}
+
+template <class TMenuItem = ui::MenuItem>
+ui::MenuItem* createIndexSubmenuItem(std::string text, std::vector<std::string> labels, std::function<size_t()> getter, std::function<void(size_t val)> setter, bool disabled = false, bool alwaysConsume = false)
+{
+	return createMenuItem<TMenuItem>(text, "", nullptr, disabled, alwaysConsume);
+}
+
+template <typename T>
+ui::MenuItem* createIndexPtrSubmenuItem(std::string text, std::vector<std::string> labels, T* ptr)
+{
+	return createMenuItem(text, "");
+}
+
+namespace app {
+
+struct ParamWidget : widget::OpaqueWidget {
+	engine::Module* module = nullptr;
+	int paramId = -1;
+
+	engine::ParamQuantity* getParamQuantity()
+	{
+		return module ? module->paramQuantities[paramId] : nullptr;
+	}
+
+	virtual void appendContextMenu(ui::Menu* menu) {}
+	void createContextMenu() {}
+};
+
+struct PortWidget : widget::OpaqueWidget {
+	engine::Module* module = nullptr;
+	int type = 0;
+	int portId = -1;
+};
+
+struct LightWidget : widget::TransparentWidget {
+	NVGcolor color;
+	NVGcolor bgColor;
+	NVGcolor borderColor;
+};
+
+struct ModuleLightWidget : LightWidget {
+	engine::Module* module = nullptr;
+	int firstLightId = -1;
+	std::vector<NVGcolor> baseColors;
+
+	void addBaseColor(NVGcolor baseColor) { baseColors.push_back(baseColor); }
+};
+
+struct SvgPanel : widget::Widget {};
+struct ThemedSvgPanel : SvgPanel {};
+
+struct ModuleWidget : widget::OpaqueWidget {
+	engine::Module* module = nullptr;
+	widget::Widget* panel = nullptr;
+	std::vector<ParamWidget*> params;
+	std::vector<PortWidget*> inputs;
+	std::vector<PortWidget*> outputs;
+
+	virtual ~ModuleWidget()
+	{
+		delete module;
+	}
+
+	void setModule(engine::Module* module) { this->module = module; }
+	engine::Module* getModule() { return module; }
+
+	template <class TModule>
+	TModule* getModule()
+	{
+		return dynamic_cast<TModule*>(module);
+	}
+
+	void setPanel(widget::Widget* panel)
+	{
+		this->panel = panel;
+		addChild(panel);
+	}
+
+	void addParam(ParamWidget* param)
+	{
+		params.push_back(param);
+		addChild(param);
+	}
+
+	void addInput(PortWidget* input)
+	{
+		inputs.push_back(input);
+		addChild(input);
+	}
+
+	void addOutput(PortWidget* output)
+	{
+		outputs.push_back(output);
+		addChild(output);
+	}
+
+	std::vector<ParamWidget*> getParams() { return params; }
+
+	ParamWidget* getParam(int paramId)
+	{
+		for (ParamWidget* param : params)
+		{
+			if (param->paramId == paramId)
+			{
+				return param;
+			}
+		}
+		return nullptr;
+	}
+	std::vector<PortWidget*> getInputs() { return inputs; }
+	std::vector<PortWidget*> getOutputs() { return outputs; }
+
+	void load(std::string filename) {}
+	void save(std::string filename) {}
+
+	virtual void appendContextMenu(ui::Menu* menu) {}
+};
+
+struct Knob : ParamWidget {
+	bool horizontal = false;
+	bool smooth = true;
+	bool snap = false;
+	float minAngle = -M_PI;
+	float maxAngle = M_PI;
+};
+
+struct SvgKnob : Knob {};
+struct SliderKnob : Knob {};
+struct SvgSwitch : ParamWidget {
+	bool momentary = false;
+	bool latch = false;
+};
+struct SvgPort : PortWidget {};
+struct SvgScrew : widget::Widget {};
+
+} // namespace app
+
+inline app::ThemedSvgPanel* createPanel(std::string svgPath, std::string darkSvgPath = "")
+{
+	return new app::ThemedSvgPanel;
+}
+
+template <class TWidget>
+TWidget* createWidget(math::Vec pos)
+{
+	TWidget* o = new TWidget;
+	o->box.pos = pos;
+	return o;
+}
+
+template <class TWidget>
+TWidget* createWidgetCentered(math::Vec pos)
+{
+	return createWidget<TWidget>(pos);
+}
+
+template <class TParamWidget>
+TParamWidget* createParam(math::Vec pos, engine::Module* module, int paramId)
+{
+	TParamWidget* o = new TParamWidget;
+	o->box.pos = pos;
+	o->module = module;
+	o->paramId = paramId;
+	return o;
+}
+
+template <class TParamWidget>
+TParamWidget* createParamCentered(math::Vec pos, engine::Module* module, int paramId)
+{
+	return createParam<TParamWidget>(pos, module, paramId);
+}
+
+template <class TPortWidget>
+TPortWidget* createInput(math::Vec pos, engine::Module* module, int inputId)
+{
+	TPortWidget* o = new TPortWidget;
+	o->box.pos = pos;
+	o->module = module;
+	o->portId = inputId;
+	return o;
+}
+
+template <class TPortWidget>
+TPortWidget* createInputCentered(math::Vec pos, engine::Module* module, int inputId)
+{
+	return createInput<TPortWidget>(pos, module, inputId);
+}
+
+template <class TPortWidget>
+TPortWidget* createOutput(math::Vec pos, engine::Module* module, int outputId)
+{
+	TPortWidget* o = new TPortWidget;
+	o->box.pos = pos;
+	o->module = module;
+	o->portId = outputId;
+	o->type = 1;
+	return o;
+}
+
+template <class TPortWidget>
+TPortWidget* createOutputCentered(math::Vec pos, engine::Module* module, int outputId)
+{
+	return createOutput<TPortWidget>(pos, module, outputId);
+}
+
+template <class TModuleLightWidget>
+TModuleLightWidget* createLight(math::Vec pos, engine::Module* module, int firstLightId)
+{
+	TModuleLightWidget* o = new TModuleLightWidget;
+	o->box.pos = pos;
+	o->module = module;
+	o->firstLightId = firstLightId;
+	return o;
+}
+
+template <class TModuleLightWidget>
+TModuleLightWidget* createLightCentered(math::Vec pos, engine::Module* module, int firstLightId)
+{
+	return createLight<TModuleLightWidget>(pos, module, firstLightId);
+}
+
+template <class TParamWidget>
+TParamWidget* createLightParam(math::Vec pos, engine::Module* module, int paramId, int firstLightId)
+{
+	TParamWidget* o = createParam<TParamWidget>(pos, module, paramId);
+	o->getLight()->module = module;
+	o->getLight()->firstLightId = firstLightId;
+	return o;
+}
+
+template <class TParamWidget>
+TParamWidget* createLightParamCentered(math::Vec pos, engine::Module* module, int paramId, int firstLightId)
+{
+	return createLightParam<TParamWidget>(pos, module, paramId, firstLightId);
+}
+
+namespace componentlibrary {
+
+struct GrayModuleLightWidget : app::ModuleLightWidget {};
+
+template <typename TBase = GrayModuleLightWidget>
+struct TWhiteLight : TBase {};
+typedef TWhiteLight<> WhiteLight;
+
+template <typename TBase = GrayModuleLightWidget>
+struct TRedLight : TBase {};
+typedef TRedLight<> RedLight;
+
+template <typename TBase = GrayModuleLightWidget>
+struct TGreenLight : TBase {};
+typedef TGreenLight<> GreenLight;
+
+template <typename TBase = GrayModuleLightWidget>
+struct TBlueLight : TBase {};
+typedef TBlueLight<> BlueLight;
+
+template <typename TBase = GrayModuleLightWidget>
+struct TYellowLight : TBase {};
+typedef TYellowLight<> YellowLight;
+
+template <typename TBase = GrayModuleLightWidget>
+struct TGreenRedLight : TBase {};
+typedef TGreenRedLight<> GreenRedLight;
+
+template <typename TBase>
+struct SmallLight : TBase {};
+template <typename TBase>
+struct MediumLight : TBase {};
+template <typename TBase>
+struct LargeLight : TBase {};
+template <typename TBase>
+struct SmallSimpleLight : TBase {};
+template <typename TBase>
+struct MediumSimpleLight : TBase {};
+template <typename TBase>
+struct LargeSimpleLight : TBase {};
+template <typename TBase>
+struct VCVBezelLight : TBase {};
+
+struct RoundKnob : app::SvgKnob {};
+struct RoundBlackKnob : RoundKnob {};
+struct RoundSmallBlackKnob : RoundKnob {};
+struct RoundLargeBlackKnob : RoundKnob {};
+struct RoundBigBlackKnob : RoundKnob {};
+struct RoundHugeBlackKnob : RoundKnob {};
+struct RoundBlackSnapKnob : RoundBlackKnob {};
+struct Trimpot : app::SvgKnob {};
+
+struct NKK : app::SvgSwitch {};
+struct CKSS : app::SvgSwitch {};
+struct CKSSThree : app::SvgSwitch {};
+struct VCVButton : app::SvgSwitch {};
+struct VCVLatch : VCVButton {};
+struct TL1105 : app::SvgSwitch {};
+
+template <typename TLight>
+struct LightButton : app::SvgSwitch {
+	app::ModuleLightWidget* light;
+
+	LightButton() { light = new TLight; }
+	app::ModuleLightWidget* getLight() { return light; }
+};
+
+template <typename TLight>
+struct VCVLightButton : LightButton<TLight> {};
+
+template <typename TLight>
+struct VCVLightLatch : VCVLightButton<TLight> {};
+
+struct PJ301MPort : app::SvgPort {};
+struct ThemedPJ301MPort : app::SvgPort {};
+struct ScrewBlack : app::SvgScrew {};
+struct ScrewSilver : app::SvgScrew {};
+struct ThemedScrew : app::SvgScrew {};
+
+} // namespace componentlibrary
+
+} // namespace rack
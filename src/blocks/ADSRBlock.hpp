@@ -1,31 +1,36 @@
 #include "plugin.hpp"
+#include "../dsp/functions.hpp"
 
 namespace musx {
 
 using namespace rack;
 using simd::float_4;
 
-class ADSRBlock {
+/**
+ * T vector type, float_4 or float_8
+ */
+template <typename T>
+class TADSRBlock {
 private:
 	float attackTarget;
 	float minTime;
 	float logLambdaBase;
 
-	float_4 gate = {};
-	float_4 attacking = {};
-	float_4 env = {};
-	dsp::TSchmittTrigger<float_4> trigger;
-	float_4 attackLambda = {};
-	float_4 decayLambda = {};
-	float_4 releaseLambda = {};
-	float_4 sustain = {};
+	T gate = {};
+	T attacking = {};
+	T env = {};
+	dsp::TSchmittTrigger<T> trigger;
+	T attackLambda = {};
+	T decayLambda = {};
+	T releaseLambda = {};
+	T sustain = {};
 
-	float_4 velScaling = {};
-	float_4 velocity = {};
+	T velScaling = {};
+	T velocity = {};
 
 public:
 	// [s]
-	ADSRBlock(float minTime = 0.001f, float maxTime = 10.f, float attackTarget = 1.2f)
+	TADSRBlock(float minTime = 0.001f, float maxTime = 10.f, float attackTarget = 1.2f)
 	{
 		this->attackTarget = attackTarget;
 		this->minTime = minTime;
@@ -33,81 +38,87 @@ public:
 	}
 
 	// [0..1]
-	void setAttackTime(float_4 t)
+	void setAttackTime(T t)
 	{
-		attackLambda = simd::exp(-t * logLambdaBase) / minTime;
+		attackLambda = fastExp(-t * logLambdaBase) / minTime;
 	}
 
-	void multAttackLambda(float_4 mult)
+	void multAttackLambda(T mult)
 	{
 		attackLambda *= mult;
 	}
 
 	// [0..1]
-	void setDecayTime(float_4 t)
+	void setDecayTime(T t)
 	{
-		decayLambda = simd::exp(-t * logLambdaBase) / minTime;
+		decayLambda = fastExp(-t * logLambdaBase) / minTime;
 	}
 
-	void multDecayLambda(float_4 mult)
+	void multDecayLambda(T mult)
 	{
 		decayLambda *= mult;
 	}
 
 	// [0..1]
-	void setSustainLevel(float_4 s)
+	void setSustainLevel(T s)
 	{
 		sustain = simd::clamp(s, 0.f, 1.f);;
 	}
 
 	// [0..1]
-	void setReleaseTime(float_4 t)
+	void setReleaseTime(T t)
 	{
-		releaseLambda = simd::exp(-t * logLambdaBase) / minTime;
+		releaseLambda = fastExp(-t * logLambdaBase) / minTime;
 	}
 
-	void multReleaseLambda(float_4 mult)
+	void multReleaseLambda(T mult)
 	{
 		releaseLambda *= mult;
 	}
 
 	// [0..1]
-	void setVelocityScaling(float_4 v)
+	void setVelocityScaling(T v)
 	{
 		velScaling = simd::clamp(v, 0.f, 1.f);;
 	}
 
-	void setGate(float_4 g)
+	void setGate(T g)
 	{
 		attacking |= ((g >= 1.f) & ~gate);
 		gate = g >= 1.f;
 	}
 
-	void setRetrigger(float_4 t)
+	void setRetrigger(T t)
 	{
-		float_4 triggered = trigger.process(t);
+		T triggered = trigger.process(t);
 		attacking |= triggered;
 	}
 
 	// [0..10]
-	void setVelocity(float_4 v)
+	void setVelocity(T v)
 	{
 		velocity = simd::clamp(v, 0.f, 10.f);;
 	}
 
-	float_4 getDecaySustainGate()
+	T getDecaySustainGate()
 	{
 		return simd::ifelse((gate & ~attacking), 10.f, 0.f);
 	}
 
-	float_4 process(float sampleTime)
+	// mask of the voices in release phase (gate low)
+	T getReleased()
+	{
+		return ~(gate | attacking);
+	}
+
+	T process(float sampleTime)
 	{
 		// Turn off attacking state if gate is LOW
 		attacking &= gate;
 
 		// Get target and lambda for exponential decay
-		float_4 target = simd::ifelse(attacking, attackTarget, simd::ifelse(gate, sustain, 0.f));
-		float_4 lambda = simd::ifelse(attacking, attackLambda, simd::ifelse(gate, decayLambda, releaseLambda));
+		T target = simd::ifelse(attacking, attackTarget, simd::ifelse(gate, sustain, 0.f));
+		T lambda = simd::ifelse(attacking, attackLambda, simd::ifelse(gate, decayLambda, releaseLambda));
 
 		// Adjust env
 		lambda = clamp(lambda, 0.f, 1.f / sampleTime);
@@ -117,7 +128,7 @@ public:
 		attacking &= (env < 1.f);
 
 		// velocity
-		float_4 scale = 1.f - velScaling +
+		T scale = 1.f - velScaling +
 				0.1f * velocity * velScaling;
 
 		// Set output
@@ -126,4 +137,6 @@ public:
 
 };
 
+typedef TADSRBlock<float_4> ADSRBlock;
+
 }
@@ -1,12 +1,17 @@
 #include "plugin.hpp"
 #include "../dsp/filters.hpp"
+#include "../dsp/random.hpp"
 
 namespace musx {
 
 using namespace rack;
 using simd::float_4;
 
-class DriftBlock {
+/**
+ * T vector type, float_4 or float_8
+ */
+template <typename T>
+class TDriftBlock {
 private:
 	int sampleRate = 48000;
 	int sampleRateReduction = 1;
@@ -14,26 +19,34 @@ private:
 	const float minFreq = 0.01f; // min freq [Hz]
 	const float base = 1000.f/minFreq; // max freq/min freq
 
-	float_4 diverge = {0.};
-	musx::TOnePole<float_4> lowpass;
+	T diverge = {0.};
+	musx::TOnePole<T> lowpass;
 
 	float driftScale = 1.f;
 
-	float_4 divergeAmount = 1.f;
-	float_4 driftAmount = 1.f;
+	T divergeAmount = 1.f;
+	T driftAmount = 1.f;
+
+	TRandom<T> rng;
 
 public:
+	// the drift noise, see TRandom::seed()
+	void seed(uint64_t s, uint64_t stream)
+	{
+		rng.seed(s, stream);
+	}
+
 	void randomizeDiverge()
 	{
-		diverge[0] = rack::random::get<float>() - 0.5f;
-		diverge[1] = rack::random::get<float>() - 0.5f;
-		diverge[2] = rack::random::get<float>() - 0.5f;
-		diverge[3] = rack::random::get<float>() - 0.5f;
+		for (int i = 0; i < T::size; i++)
+		{
+			diverge[i] = rack::random::get<float>() - 0.5f;
+		}
 
 		diverge *= 10.f; // +-5V
 	}
 
-	void setDiverge(float_4 d)
+	void setDiverge(T d)
 	{
 		diverge = d;
 	}
@@ -43,7 +56,7 @@ public:
 		diverge[i] = d;
 	}
 
-	float_4 getDiverge()
+	T getDiverge()
 	{
 		return diverge;
 	}
@@ -68,27 +81,27 @@ public:
 		lowpass.tmp = simd::clamp(lowpass.tmp, -5.f/driftScale, 5.f/driftScale);
 	}
 
-	void setDivergeAmount(float_4 d)
+	void setDivergeAmount(T d)
 	{
 		divergeAmount = d;
 	}
 
-	void setDriftAmount(float_4 d)
+	void setDriftAmount(T d)
 	{
 		driftAmount = d;
 	}
 
-	float_4 process()
+	T process()
 	{
-		float_4 rn = {rack::random::get<float>() - 0.5f,
-				   	  rack::random::get<float>() - 0.5f,
-					  rack::random::get<float>() - 0.5f,
-					  rack::random::get<float>() - 0.5f};
+		T rn = rng.uniform() - 0.5f;
 
 		lowpass.process(rn);
-		float_4 drift = lowpass.lowpass();
+		T drift = lowpass.lowpass();
 
 		return simd::clamp(divergeAmount * diverge + driftAmount * driftScale * drift, -10.f, 10.f);
 	}
 };
+
+typedef TDriftBlock<float_4> DriftBlock;
+
 }
@@ -7,26 +7,32 @@ using namespace rack;
 using simd::float_4;
 using simd::int32_4;
 
-class LFOBlock {
+/**
+ * T vector type, float_4 or float_8
+ */
+template <typename T>
+class TLFOBlock {
 private:
+	typedef simd::Vector<int32_t, T::size> TInt;
+
 	int sampleRate = 48000;
 	int sampleRateReduction = 1;
 
-	float_4 rand4 = {0.f};
+	T rand4 = {0.f};
 
 	// integers overflow, so phase resets automatically
-	int32_4 phasor = {INT32_MIN};
-	int32_4 lastPhasor = {INT32_MIN};
-	int32_4 phaseInc = {0};
-	float_4 wave = {0}; // -1..1
+	TInt phasor = {INT32_MIN};
+	TInt lastPhasor = {INT32_MIN};
+	TInt phaseInc = {0};
+	T wave = {0}; // -1..1
 
-	float_4 amp = {1.};
+	T amp = {1.};
 
-	float_4 reset = {0};
+	T reset = {0};
 
 	size_t shape = 0;
 
-	int32_4 singleCycle = castFloatMaskToInt(float_4::zero());
+	TInt singleCycle = castFloatMaskToInt(T::zero());
 
 public:
 	static std::vector<std::string> getShapeLabels()
@@ -51,7 +57,7 @@ public:
 	}
 
 	// [0..1]
-	void setRand(float_4 rnd)
+	void setRand(T rnd)
 	{
 		rand4 = rnd;
 	}
@@ -75,29 +81,29 @@ public:
 	{
 		if (s)
 		{
-			singleCycle = castFloatMaskToInt(float_4::mask());
+			singleCycle = castFloatMaskToInt(T::mask());
 		}
 		else
 		{
-			singleCycle = castFloatMaskToInt(float_4::zero());
+			singleCycle = castFloatMaskToInt(T::zero());
 		}
 	}
 
 	// 0V = 2Hz
-	void setFrequencyVOct(float_4 f)
+	void setFrequencyVOct(T f)
 	{
-		float_4 freq = dsp::exp2_taylor5(f);
+		T freq = fastExp2(f);
 		phaseInc = INT32_MAX / sampleRate * freq * sampleRateReduction;
 	}
 
-	void setAmp(float_4 a)
+	void setAmp(T a)
 	{
 		amp = clamp(a, 0.f, 10.f);
 	}
 
-	void setReset(float_4 rst)
+	void setReset(T rst)
 	{
-		float_4 mask = rst > (reset + 0.5f);
+		T mask = rst > (reset + 0.5f);
 		phasor += castFloatMaskToInt(mask) & (-phasor + INT32_MIN);
 		lastPhasor += castFloatMaskToInt(mask) & (-lastPhasor + INT32_MAX);
 		reset = rst;
@@ -110,13 +116,13 @@ public:
 
 	void process()
 	{
-		float_4 doSample = -(lastPhasor > phasor);
-		float_4 phase;
+		T doSample = -(lastPhasor > phasor);
+		T phase;
 
 		lastPhasor = phasor;
 
 		// get phase inc
-		int32_4 realPhaseInc = 2*phaseInc;
+		TInt realPhaseInc = 2*phaseInc;
 		switch(shape)
 		{
 		case 6:
@@ -135,27 +141,27 @@ public:
 		{
 			case 0:
 				// sine
-				wave = fastCos((float_4)(phasor/INT32_MAX)*M_PI);
+				wave = fastCos((T)(phasor/INT32_MAX)*M_PI);
 				break;
 			case 1:
 				// tri
-				wave = 2. * simd::ifelse(phasor < 0, (float_4)(phasor/INT32_MAX), -(float_4)(phasor/INT32_MAX)) + 1.;
+				wave = 2. * simd::ifelse(phasor < 0, (T)(phasor/INT32_MAX), -(T)(phasor/INT32_MAX)) + 1.;
 				break;
 			case 2:
 				// square
-				wave = 2. * (float_4)(phasor > 0 * 2. - 1.) + 1.;
+				wave = 2. * (T)(phasor > 0 * 2. - 1.) + 1.;
 				break;
 			case 3:
 				// pulse
-				wave = 2. * (float_4)(phasor > -INT32_MAX/4 * 2. - 1.) + 1.;
+				wave = 2. * (T)(phasor > -INT32_MAX/4 * 2. - 1.) + 1.;
 				break;
 			case 4:
 				// ramp
-				wave = (float_4)(phasor/INT32_MAX);
+				wave = (T)(phasor/INT32_MAX);
 				break;
 			case 5:
 				// saw
-				wave = -(float_4)(phasor/INT32_MAX);
+				wave = -(T)(phasor/INT32_MAX);
 				break;
 			case 6:
 				// s&h
@@ -172,14 +178,17 @@ public:
 		}
 	}
 
-	float_4 getUnipolar() const
+	T getUnipolar() const
 	{
 		return amp * (wave + 1.f);
 	}
 
-	float_4 getBipolar() const
+	T getBipolar() const
 	{
 		return amp * wave;
 	}
 };
+
+typedef TLFOBlock<float_4> LFOBlock;
+
 }
@@ -11,14 +11,17 @@ using simd::int32_4;
 
 /**
  * O max oversampling
+ * T vector type, float_4 or float_8
  */
-template <size_t O>
+template <size_t O, typename T = float_4>
 class OscillatorsBlock {
 private:
+	typedef simd::Vector<int32_t, T::size> TInt;
+
 	// phase accumulators. integers overflow, so phase resets automatically
-	int32_4 phasor1Sub = {0};
-	int32_4 phasor1Old = {0};
-	int32_4 phasor2 = {0};
+	TInt phasor1Sub = {0};
+	TInt phasor1Old = {0};
+	TInt phasor2 = {0};
 
 	// sample rates
 	int sampleRate = 48000;
@@ -30,45 +33,45 @@ private:
 	float maxFreq = 20000.f; // [Hz]
 
 	// parameters
-	float_4 osc1Freq = {440.}; // [Hz]
-	float_4 osc1Shape = {0};
-	float_4 osc1PW = {0};
-	float_4 osc1Vol = {0};
-	float_4 osc1Pan = {0};
-	float_4 osc1Subvol = {0};
-	float_4 osc1SubPan = {0};
-
-	float_4 osc2Freq = {440.}; // [Hz]
-	float_4 osc2Shape = {0};
-	float_4 osc2PW = {0};
-	float_4 osc2Vol = {0};
-	float_4 osc2Pan = {0};
-
-	float_4 syncMask = {0};
+	T osc1Freq = {440.}; // [Hz]
+	T osc1Shape = {0};
+	T osc1PW = {0};
+	T osc1Vol = {0};
+	T osc1Pan = {0};
+	T osc1Subvol = {0};
+	T osc1SubPan = {0};
+
+	T osc2Freq = {440.}; // [Hz]
+	T osc2Shape = {0};
+	T osc2PW = {0};
+	T osc2Vol = {0};
+	T osc2Pan = {0};
+
+	T syncMask = {0};
 	int calcFm = 0;
-	float_4 fmUnscaled = {0};
-	float_4 fmAmt = {0};
-	float_4 ringmodVol = {0};
-	float_4 ringmodPan = {0};
+	T fmUnscaled = {0};
+	T fmAmt = {0};
+	T ringmodVol = {0};
+	T ringmodPan = {0};
 
 	// more parameters
-	int32_4 phase1SubInc = {0};
-	int32_4 phase1Inc = {0};
-	float_4 tri1Amt = {0};
-	float_4 sawSq1Amt  = {0};
-	float_4 sq1Amt = {0};
-	int32_4 phase1Offset = {0};
+	TInt phase1SubInc = {0};
+	TInt phase1Inc = {0};
+	T tri1Amt = {0};
+	T sawSq1Amt  = {0};
+	T sq1Amt = {0};
+	TInt phase1Offset = {0};
 
 	int calcTri1 = 0;
 	int calcSawSq1 = 0;
 	int calcSq1 = 0;
 	int calcSub = 0;
 
-	int32_4 phase2Inc = {0};
-	float_4 tri2Amt = {0};
-	float_4 sawSq2Amt = {0};
-	float_4 sq2Amt = {0};
-	int32_4 phase2Offset = {0};
+	TInt phase2Inc = {0};
+	T tri2Amt = {0};
+	T sawSq2Amt = {0};
+	T sq2Amt = {0};
+	TInt phase2Offset = {0};
 
 	int calcSync = 0;
 	int calcTri2 = 0;
@@ -77,16 +80,16 @@ private:
 
 	// blep generators
 	static constexpr size_t blepSize = 4;
-	BlepGenerator<O, blepSize, float_4> osc1Blep;
-	BlepGenerator<O, blepSize, float_4> oscSubBlep;
-	BlepGenerator<O, blepSize, float_4> osc2Blep;
+	BlepGenerator<O, blepSize, T> osc1Blep;
+	BlepGenerator<O, blepSize, T> oscSubBlep;
+	BlepGenerator<O, blepSize, T> osc2Blep;
 
 	// buffer for applying 4-point blep
 	size_t bufferReadIndex = 0;
 	size_t bufferWriteIndex = oversamplingRate * blepSize / 2 - 1;
-	float_4 prevSub1 [O * blepSize / 2] = {0};
-	float_4 prevWave1[O * blepSize / 2] = {0};
-	float_4 prevWave2[O * blepSize / 2] = {0};
+	T prevSub1 [O * blepSize / 2] = {0};
+	T prevWave1[O * blepSize / 2] = {0};
+	T prevWave2[O * blepSize / 2] = {0};
 
 	void setPhase1Inc()
 	{
@@ -141,23 +144,23 @@ public:
 
 
 	// set oscillator 1 frequency in V/Oct. 0 V = C4 [V]
-	inline void setOsc1FreqVOct(float_4 freq)
+	inline void setOsc1FreqVOct(T freq)
 	{
-		osc1Freq = simd::clamp(dsp::FREQ_C4 * dsp::exp2_taylor5(freq), minFreq, maxFreq);
+		osc1Freq = simd::clamp(dsp::FREQ_C4 * fastExp2(freq), minFreq, maxFreq);
 		if (calcFm) setFmAmount(fmUnscaled);
 		setPhase1Inc();
 	}
 
 	// set oscillator 1 frequency in V/Oct. 0 V = 2 Hz [V]
-	inline void setOsc1FreqVOctLFO(float_4 freq)
+	inline void setOsc1FreqVOctLFO(T freq)
 	{
-		osc1Freq = simd::clamp(2. * dsp::exp2_taylor5(freq), minFreq, maxFreq);
+		osc1Freq = simd::clamp(2. * fastExp2(freq), minFreq, maxFreq);
 		if (calcFm) setFmAmount(fmUnscaled);
 		setPhase1Inc();
 	}
 
 	// set oscillator 1 frequency [Hz]
-	inline void setOsc1FreqHz(float_4 freq)
+	inline void setOsc1FreqHz(T freq)
 	{
 		osc1Freq = simd::clamp(freq, minFreq, maxFreq);
 		if (calcFm) setFmAmount(fmUnscaled);
@@ -165,7 +168,7 @@ public:
 	}
 
 	// set oscillator 1 shape [-1..1]
-	inline void setOsc1Shape(float_4 shape)
+	inline void setOsc1Shape(T shape)
 	{
 		osc1Shape = simd::clamp(shape, -1.f, 1.f);
 
@@ -179,27 +182,27 @@ public:
 	}
 
 	// set oscillator 1 pulsewidth [-1..1]
-	inline void setOsc1PW(float_4 pw)
+	inline void setOsc1PW(T pw)
 	{
 		osc1PW = simd::clamp(pw, -1.f, 1.f);
 		phase1Offset = simd::ifelse(osc1PW < 0, (-1.f - osc1PW) * INT32_MAX, (1.f - osc1PW) * INT32_MAX); // for pulse wave = saw + inverted saw with phaseshift
 	}
 
 	// set oscillator 1 volume [0..1]
-	inline void setOsc1Vol(float_4 vol)
+	inline void setOsc1Vol(T vol)
 	{
 		osc1Vol  = simd::clamp(vol, 0.f, 1.f);
 		osc1Vol *= 10.f / INT32_MAX;
 	}
 
 	// set oscillator 1 pan [-1..1]
-	inline void setOsc1Pan(float_4 pan)
+	inline void setOsc1Pan(T pan)
 	{
 		osc1Pan = simd::clamp(pan, -1.f, 1.f);
 	}
 
 	// set oscillator 1 suboscillator volume [0..1]
-	inline void setOsc1Subvol(float_4 vol)
+	inline void setOsc1Subvol(T vol)
 	{
 		osc1Subvol  = simd::clamp(vol, 0.f, 1.f);
 		osc1Subvol *= 10.f / INT32_MAX;
@@ -208,29 +211,29 @@ public:
 	}
 
 	// set oscillator 1 suboscillator pan [-1..1]
-	inline void setOsc1SubPan(float_4 pan)
+	inline void setOsc1SubPan(T pan)
 	{
 		osc1SubPan = simd::clamp(pan, -1.f, 1.f);
 	}
 
 	// set oscillator 2 frequency in V/Oct. 0 V = C4 [V]
-	inline void setOsc2FreqVOct(float_4 freq)
+	inline void setOsc2FreqVOct(T freq)
 	{
-		osc2Freq = simd::clamp(dsp::FREQ_C4 * dsp::exp2_taylor5(freq), minFreq, maxFreq);
+		osc2Freq = simd::clamp(dsp::FREQ_C4 * fastExp2(freq), minFreq, maxFreq);
 		if (calcFm) setFmAmount(fmUnscaled);
 		setPhase2Inc();
 	}
 
 	// set oscillator 2 frequency in V/Oct. 0 V = 2 Hz [V]
-	inline void setOsc2FreqVOctLFO(float_4 freq)
+	inline void setOsc2FreqVOctLFO(T freq)
 	{
-		osc2Freq = simd::clamp(2. * dsp::exp2_taylor5(freq), minFreq, maxFreq);
+		osc2Freq = simd::clamp(2. * fastExp2(freq), minFreq, maxFreq);
 		if (calcFm) setFmAmount(fmUnscaled);
 		setPhase2Inc();
 	}
 
 	// set oscillator 2 frequency [Hz]
-	inline void setOsc2Freq(float_4 freq)
+	inline void setOsc2Freq(T freq)
 	{
 		osc2Freq = simd::clamp(freq, minFreq, maxFreq);
 		if (calcFm) setFmAmount(fmUnscaled);
@@ -238,7 +241,7 @@ public:
 	}
 
 	// set oscillator 2 shape [-1..1]
-	inline void setOsc2Shape(float_4 shape)
+	inline void setOsc2Shape(T shape)
 	{
 		osc2Shape = simd::clamp(shape, -1.f, 1.f);
 
@@ -252,35 +255,35 @@ public:
 	}
 
 	// set oscillator 2 pulsewidth [-1..1]
-	inline void setOsc2PW(float_4 pw)
+	inline void setOsc2PW(T pw)
 	{
 		osc2PW = simd::clamp(pw, -1.f, 1.f);
 		phase2Offset = simd::ifelse(osc2PW < 0, (-1.f - osc2PW) * INT32_MAX, (1.f - osc2PW) * INT32_MAX); // for pulse wave
 	}
 
 	// set oscillator 2 volume [0..1]
-	inline void setOsc2Vol(float_4 vol)
+	inline void setOsc2Vol(T vol)
 	{
 		osc2Vol  = simd::clamp(vol, 0.f, 1.f);
 		osc2Vol *= 10.f / INT32_MAX;
 	}
 
 	// set oscillator 2 pan [-1..1]
-	inline void setOsc2Pan(float_4 pan)
+	inline void setOsc2Pan(T pan)
 	{
 		osc2Pan = simd::clamp(pan, -1.f, 1.f);
 	}
 
 
 	// set if oscillator 2 should be synced to oscillator 1 [0, 1]
-	inline void setSync(float_4 s)
+	inline void setSync(T s)
 	{
 		syncMask = s > 0.5f; // 0x00000000 or 0xffffffff
 		calcSync = simd::movemask(syncMask);
 	}
 
 	// set oscillator 1 -> oscillator 2 frequency-modulation amount [0..1]
-	inline void setFmAmount(float_4 fm)
+	inline void setFmAmount(T fm)
 	{
 		calcFm = simd::movemask(fm > 1.e-6f);
 
@@ -289,7 +292,7 @@ public:
 		// use adapted carsons rule to limit FM amount
 		// value 7000 is chosen so that
 		// osc 2 fm'ed fundamental frequency stays below nyquist (oversamplingRate*sampleRate/2.)
-		float_4 maxFm = simd::fmax(
+		T maxFm = simd::fmax(
 				((oversamplingRate*sampleRate/2. - osc2Freq) / 2. - osc1Freq) / 7000.,
 				0.f);
 		fmAmt = simd::fmin(fmUnscaled * fmUnscaled, maxFm);
@@ -298,14 +301,14 @@ public:
 	}
 
 	// set ringmodulator volume [0..1]
-	inline void setRingmodVol(float_4 vol)
+	inline void setRingmodVol(T vol)
 	{
 		ringmodVol  = simd::clamp(vol, 0.f, 1.f);
 		ringmodVol *= 10.f / INT32_MAX / INT32_MAX;
 	}
 
 	// set ringmodulator pan [-1..1]
-	inline void setRingmodPan(float_4 pan)
+	inline void setRingmodPan(T pan)
 	{
 		ringmodPan = simd::clamp(pan, -1.f, 1.f);
 	}
@@ -315,38 +318,42 @@ public:
 	// output can have DC offset when using fm or ringmod
 	// output in NOT bound to +-10V. The individual components (osc1, subosc, osc2, ringmod) are within +-10V
 	// it is recommended to feed the output through a DC blocker and saturator
-	void process(float_4* buffer)
+	// OSR is the oversampling rate if it is known at compile time, 0 otherwise
+	template <int OSR = 0>
+	void process(T* buffer)
 	{
+		const int rate = OSR ? OSR : oversamplingRate;
+
 		// calculate the oversampled oscillators and mix
-		for (int i = 0; i < oversamplingRate; ++i)
+		for (int i = 0; i < rate; ++i)
 		{
 			// phasors for subosc 1 and osc 1
 			phasor1Sub += phase1SubInc;
-			int32_4 phasor1 = phasor1Sub + phasor1Sub;
-			int32_4 phasor1Offset = phasor1 + phase1Offset;
+			TInt phasor1 = phasor1Sub + phasor1Sub;
+			TInt phasor1Offset = phasor1 + phase1Offset;
 
 			// osc 1 waveform
-			float_4 wave1 = -2.f * tri1Amt * (simd::abs(phasor1Offset) - INT32_MAX/2); // +-INT32_MAX
+			T wave1 = -2.f * tri1Amt * (simd::abs(phasor1Offset) - INT32_MAX/2); // +-INT32_MAX
 			wave1 += sawSq1Amt * (phasor1Offset * sq1Amt - 1.f * phasor1); // +-INT32_MAX
 
 			// osc 1 suboscillator
-			float_4 sub1 = 1.f * (phasor1Sub + INT32_MAX) - 1.f * phasor1Sub; // +-INT32_MAX
+			T sub1 = 1.f * (phasor1Sub + INT32_MAX) - 1.f * phasor1Sub; // +-INT32_MAX
 
 			// phasor for osc 2
-			phasor2 += phase2Inc + int32_4(fmAmt * wave1);
+			phasor2 += phase2Inc + TInt(fmAmt * wave1);
 
 			// syncMask / reset phasor2 ?
-			int32_4 resetPhaseMask = phasor1Old > phasor1;
+			TInt resetPhaseMask = phasor1Old > phasor1;
 			phasor2 = simd::ifelse(syncMask & musx::castIntMaskToFloat(resetPhaseMask), INT32_MIN, phasor2);
 			phasor1Old = phasor1;
-			int32_4 phasor2Offset = phasor2 + phase2Offset;
+			TInt phasor2Offset = phasor2 + phase2Offset;
 
 			// osc 2 waveform
-			float_4 wave2 = -2.f * tri2Amt * (simd::abs(phasor2Offset) - INT32_MAX/2); // +-INT32_MAX
+			T wave2 = -2.f * tri2Amt * (simd::abs(phasor2Offset) - INT32_MAX/2); // +-INT32_MAX
 			wave2 += sawSq2Amt * (phasor2Offset * sq2Amt - 1.f * phasor2); // +-INT32_MAX
 
 			// mix
-			float_4 out = osc1Subvol * sub1 + osc1Vol * wave1 + osc2Vol * wave2 + ringmodVol * wave1 * wave2; // +-5V each
+			T out = osc1Subvol * sub1 + osc1Vol * wave1 + osc2Vol * wave2 + ringmodVol * wave1 * wave2; // +-5V each
 
 			buffer[i] = out;
 		}
@@ -356,16 +363,20 @@ public:
 	// output can have DC offset when using fm or ringmod
 	// output in NOT bound to +-10V. The individual components (osc1, subosc, osc2, ringmod) are within +-10V
 	// it is recommended to feed the output through a DC blocker and saturator
-	void processBandlimited(float_4* bufferLMono, float_4* bufferR = nullptr)
+	// OSR is the oversampling rate if it is known at compile time, 0 otherwise
+	template <int OSR = 0>
+	void processBandlimited(T* bufferLMono, T* bufferR = nullptr)
 	{
+		const int rate = OSR ? OSR : oversamplingRate;
+
 		// calculate the oversampled oscillators and mix
-		for (int i = 0; i < oversamplingRate; ++i)
+		for (int i = 0; i < rate; ++i)
 		{
-			float_4 sub1 = 0;
-			float_4 wave1 = 0;
-			float_4 wave2 = 0;
-			float_4 outLMono = 0;
-			float_4 outR = 0;
+			T sub1 = 0;
+			T wave1 = 0;
+			T wave2 = 0;
+			T outLMono = 0;
+			T outR = 0;
 
 
 			//
@@ -373,21 +384,21 @@ public:
 			//
 
 			// phasors for osc 1
-			int32_4 phasor1 = phasor1Sub + phasor1Sub;
-			int32_4 phasor1Offset = phasor1 + phase1Offset;
+			TInt phasor1 = phasor1Sub + phasor1Sub;
+			TInt phasor1Offset = phasor1 + phase1Offset;
 
 			if (calcTri1)
 			{
-				float_4 tri1 = -2 * simd::abs(phasor1Offset) + INT32_MAX; // +-INT32_MAX
+				T tri1 = -2 * simd::abs(phasor1Offset) + INT32_MAX; // +-INT32_MAX
 
 				wave1 += tri1Amt * tri1; // +-INT32_MAX
 
-				int32_4 effPhasor = phasor1Offset + phasor1Offset + INT32_MAX;
+				TInt effPhasor = phasor1Offset + phasor1Offset + INT32_MAX;
 				osc1Blep.insertBlamp(
 						(1.f * effPhasor + 2.f * phase1Inc > 1.f * INT32_MAX),
 						(1.f * INT32_MAX - 1.f * effPhasor) / (2.f * phase1Inc),
-						simd::sgn(float_4(phasor1Offset)) * tri1Amt * phase1Inc,
-						oversamplingRate);
+						simd::sgn(T(phasor1Offset)) * tri1Amt * phase1Inc,
+						rate);
 			}
 
 			if (calcSawSq1)
@@ -400,7 +411,7 @@ public:
 							getBlepMask(phasor1Offset, phase1Inc),
 							(INT32_MAX - phasor1Offset) / (1.f * phase1Inc),
 							-sawSq1Amt * sq1Amt * INT32_MAX,
-							oversamplingRate);
+							rate);
 				}
 				else
 				{
@@ -411,12 +422,12 @@ public:
 						getBlepMask(phasor1, phase1Inc),
 						(INT32_MAX - phasor1) / (1.f * phase1Inc),
 						sawSq1Amt * INT32_MAX,
-						oversamplingRate);
+						rate);
 			}
 
 			if (calcSub)
 			{
-				int32_4 phasor1SubOffset = phasor1Sub + INT32_MAX;
+				TInt phasor1SubOffset = phasor1Sub + INT32_MAX;
 
 				sub1 = 1.f * phasor1SubOffset - 1.f * phasor1Sub; // +-INT32_MAX
 
@@ -424,18 +435,18 @@ public:
 						getBlepMask(phasor1Sub, phase1SubInc),
 						simd::clamp((INT32_MAX - phasor1Sub) / (1.f * phase1SubInc), 0.f , 1.f),
 						INT32_MAX,
-						oversamplingRate);
+						rate);
 
 				oscSubBlep.insertBlep(
 						getBlepMask(phasor1SubOffset, phase1SubInc),
 						simd::clamp((INT32_MAX - phasor1SubOffset) / (1.f * phase1SubInc), 0.f , 1.f),
 						-INT32_MAX,
-						oversamplingRate);
+						rate);
 
 				if (bufferR)
 				{
-					outLMono += osc1Subvol * panGetVolL<float_4>(osc1SubPan) * (prevSub1[bufferReadIndex] + oscSubBlep.process());
-					outR += osc1Subvol * panGetVolR<float_4>(osc1SubPan) * (prevSub1[bufferReadIndex] + oscSubBlep.process());
+					outLMono += osc1Subvol * panGetVolL<T>(osc1SubPan) * (prevSub1[bufferReadIndex] + oscSubBlep.process());
+					outR += osc1Subvol * panGetVolR<T>(osc1SubPan) * (prevSub1[bufferReadIndex] + oscSubBlep.process());
 				}
 				else
 				{
@@ -454,23 +465,23 @@ public:
 			//
 
 			// phasors for osc 2
-			int32_4 phase2IncWithFm = phase2Inc + int32_4(fmAmt * prevWave1[bufferReadIndex]); // can be negative!
+			TInt phase2IncWithFm = phase2Inc + TInt(fmAmt * prevWave1[bufferReadIndex]); // can be negative!
 
-			float_4 blep2Scale = simd::sgn(float_4(phase2IncWithFm)) * INT32_MAX; // [-INT32_MAX, INT32_MAX]
+			T blep2Scale = simd::sgn(T(phase2IncWithFm)) * INT32_MAX; // [-INT32_MAX, INT32_MAX]
 			if (calcSync)
 			{
-				float_4 syncBlepMask = getBlepMask(phasor1, phase1Inc);
-				float_4 doSyncMask = syncMask & syncBlepMask;
+				T syncBlepMask = getBlepMask(phasor1, phase1Inc);
+				T doSyncMask = syncMask & syncBlepMask;
 
 				if (simd::movemask(doSyncMask))
 				{
-					float_4 fractionalSyncTime = (INT32_MAX - phasor1) / (1.f * phase1Inc); // [0..1]
+					T fractionalSyncTime = (INT32_MAX - phasor1) / (1.f * phase1Inc); // [0..1]
 					fractionalSyncTime = simd::clamp(fractionalSyncTime, 0.f, 1.0f);
 					fractionalSyncTime = simd::ifelse(doSyncMask, fractionalSyncTime, 1.f); // get rid of some numerical errors
 
-					int32_4 phase2IncWithFmBeforeSync = phase2IncWithFm;
-					phase2IncWithFmBeforeSync -= castFloatMaskToInt(doSyncMask) & int32_4((1.f - fractionalSyncTime) * phase2IncWithFm);
-					int32_4 phase2IncWithFmAfterSync = phase2IncWithFm - phase2IncWithFmBeforeSync;
+					TInt phase2IncWithFmBeforeSync = phase2IncWithFm;
+					phase2IncWithFmBeforeSync -= castFloatMaskToInt(doSyncMask) & TInt((1.f - fractionalSyncTime) * phase2IncWithFm);
+					TInt phase2IncWithFmAfterSync = phase2IncWithFm - phase2IncWithFmBeforeSync;
 
 					// calc osc2 and bleps from sample begin to fractionalSyncTime
 					calcOsc2(phase2IncWithFmBeforeSync,
@@ -480,16 +491,16 @@ public:
 							fractionalSyncTime);
 
 					// calc osc2 wave right before sync for blep scale
-					float_4 wave2BeforeSync = 0.f;
+					T wave2BeforeSync = 0.f;
 					calcOsc2Wave(wave2BeforeSync);
 
 					// syncMask? -> reset phasor2
-					phasor2 += castFloatMaskToInt(doSyncMask) & -phasor2 + INT32_MIN; // reset to INT32_MIN
-					int32_4 scaleMask = phase2IncWithFm < 0;
+					phasor2 += castFloatMaskToInt(doSyncMask) & (-phasor2 + INT32_MIN); // reset to INT32_MIN
+					TInt scaleMask = phase2IncWithFm < 0;
 					phasor2 += scaleMask & -1; // roll over to INT32_MAX if phase2IncWithFm < 0
 
 					// calc osc2 wave right after sync for blep scale
-					float_4 wave2AfterSync = 0.f;
+					T wave2AfterSync = 0.f;
 					calcOsc2Wave(wave2AfterSync);
 
 					// insert blep for sync
@@ -497,7 +508,7 @@ public:
 							syncBlepMask,
 							fractionalSyncTime,
 							0.5 * (wave2AfterSync - wave2BeforeSync),
-							oversamplingRate);
+							rate);
 
 					// calc osc2 bleps from fractionalSyncTime to sample end
 					calcOsc2Bleps(phase2IncWithFmAfterSync,
@@ -527,15 +538,15 @@ public:
 			// mix
 			if (bufferR)
 			{
-				outLMono += osc1Vol * panGetVolL<float_4>(osc1Pan) * prevWave1[bufferReadIndex] +
-						osc2Vol * panGetVolL<float_4>(osc2Pan) * prevWave2[bufferReadIndex] +
-						ringmodVol * panGetVolL<float_4>(ringmodPan) * prevWave1[bufferReadIndex] * prevWave2[bufferReadIndex]; // +-5V each
+				outLMono += osc1Vol * panGetVolL<T>(osc1Pan) * prevWave1[bufferReadIndex] +
+						osc2Vol * panGetVolL<T>(osc2Pan) * prevWave2[bufferReadIndex] +
+						ringmodVol * panGetVolL<T>(ringmodPan) * prevWave1[bufferReadIndex] * prevWave2[bufferReadIndex]; // +-5V each
 
 				bufferLMono[i] = outLMono;
 
-				outR += osc1Vol * panGetVolR<float_4>(osc1Pan) * prevWave1[bufferReadIndex] +
-						osc2Vol * panGetVolR<float_4>(osc2Pan) * prevWave2[bufferReadIndex] +
-						ringmodVol * panGetVolR<float_4>(ringmodPan) * prevWave1[bufferReadIndex] * prevWave2[bufferReadIndex]; // +-5V each
+				outR += osc1Vol * panGetVolR<T>(osc1Pan) * prevWave1[bufferReadIndex] +
+						osc2Vol * panGetVolR<T>(osc2Pan) * prevWave2[bufferReadIndex] +
+						ringmodVol * panGetVolR<T>(ringmodPan) * prevWave1[bufferReadIndex] * prevWave2[bufferReadIndex]; // +-5V each
 
 				bufferR[i] = outR;
 			}
@@ -554,7 +565,7 @@ public:
 			prevWave2[bufferWriteIndex] = wave2;
 
 			bufferReadIndex = (bufferReadIndex + 1) & (O * blepSize / 2 - 1);
-			bufferWriteIndex = (bufferReadIndex + oversamplingRate * blepSize / 2 - 1) & (O * blepSize / 2 - 1);
+			bufferWriteIndex = (bufferReadIndex + rate * blepSize / 2 - 1) & (O * blepSize / 2 - 1);
 
 		}
 	}
@@ -566,25 +577,25 @@ private:
 	 * insert bleps and blamp
 	 * advance phasor2 by phase2IncWithFm
 	 */
-	void calcOsc2(int32_4 phase2IncWithFm,
-			float_4 blep2Scale,
-			float_4& wave2,
-			float_4 minTime = 0.f,
-			float_4 maxTime = 1.f)
+	void calcOsc2(TInt phase2IncWithFm,
+			T blep2Scale,
+			T& wave2,
+			T minTime = 0.f,
+			T maxTime = 1.f)
 	{
-		int32_4 phasor2Offset = phasor2 + phase2Offset;
+		TInt phasor2Offset = phasor2 + phase2Offset;
 
 		if (calcTri2)
 		{
-			float_4 tri2 = -2 * simd::abs(phasor2Offset) + INT32_MAX; // +-INT32_MAX
+			T tri2 = -2 * simd::abs(phasor2Offset) + INT32_MAX; // +-INT32_MAX
 
 			wave2 += tri2Amt * tri2; // +-INT32_MAX
 
-			int32_4 effPhasor = phasor2Offset + phasor2Offset + INT32_MAX;
+			TInt effPhasor = phasor2Offset + phasor2Offset + INT32_MAX;
 			osc2Blep.insertBlamp(
 					(1.f * effPhasor + 2.f * phase2IncWithFm > 1.f * INT32_MAX),
 					maxTime * (minTime + (1.f * INT32_MAX - 1.f * effPhasor) / (2.f * phase2IncWithFm)),
-					simd::sgn(float_4(phasor2Offset)) * tri2Amt * phase2IncWithFm,
+					simd::sgn(T(phasor2Offset)) * tri2Amt * phase2IncWithFm,
 					oversamplingRate);
 		}
 
@@ -618,13 +629,13 @@ private:
 	/**
 	 * calc wave2 at beginning of sample
 	 */
-	void calcOsc2Wave(float_4& wave2)
+	void calcOsc2Wave(T& wave2)
 	{
-		int32_4 phasor2Offset = phasor2 + phase2Offset;
+		TInt phasor2Offset = phasor2 + phase2Offset;
 
 		if (calcTri2)
 		{
-			float_4 tri2 = -2 * simd::abs(phasor2Offset) + INT32_MAX; // +-INT32_MAX
+			T tri2 = -2 * simd::abs(phasor2Offset) + INT32_MAX; // +-INT32_MAX
 
 			wave2 += tri2Amt * tri2; // +-INT32_MAX
 		}
@@ -646,19 +657,19 @@ private:
 	 * insert bleps and blamp
 	 * advance phasor2 by ph
 	 */
-	void calcOsc2Bleps(int32_4 phase2IncWithFm,
-			float_4 blep2Scale,
-			float_4 timeOffset = 0.)
+	void calcOsc2Bleps(TInt phase2IncWithFm,
+			T blep2Scale,
+			T timeOffset = 0.)
 	{
-		int32_4 phasor2Offset = phasor2 + phase2Offset;
+		TInt phasor2Offset = phasor2 + phase2Offset;
 
 		if (calcTri2)
 		{
-			int32_4 effPhasor = phasor2Offset + phasor2Offset + INT32_MAX;
+			TInt effPhasor = phasor2Offset + phasor2Offset + INT32_MAX;
 			osc2Blep.insertBlamp(
 					(1.f * effPhasor + 2.f * phase2IncWithFm > 1.f * INT32_MAX),
 					(INT32_MAX - effPhasor) / (2.f * phase2IncWithFm),
-					simd::sgn(float_4(phasor2Offset)) * tri2Amt * phase2IncWithFm,
+					simd::sgn(T(phasor2Offset)) * tri2Amt * phase2IncWithFm,
 					oversamplingRate);
 		}
 
@@ -683,19 +694,19 @@ private:
 	}
 
 	// assumes phaseInc > 0
-	float_4 getBlepMask(int32_4 phasor, int32_4 phaseInc)
+	T getBlepMask(TInt phasor, TInt phaseInc)
 	{
-		int32_4 phasorResetMaskInt = (phasor + phaseInc) < phasor;
+		TInt phasorResetMaskInt = (phasor + phaseInc) < phasor;
 		return castIntMaskToFloat(phasorResetMaskInt);
 	}
 
-	float_4 getBlepMaskSigned(int32_4 phasor, int32_4 phaseInc)
+	T getBlepMaskSigned(TInt phasor, TInt phaseInc)
 	{
-		int32_4 phasorResetMaskIntPos = (phasor + phaseInc) < phasor;
-		float_4 phasorResetMaskFloatPos = castIntMaskToFloat(phasorResetMaskIntPos);
+		TInt phasorResetMaskIntPos = (phasor + phaseInc) < phasor;
+		T phasorResetMaskFloatPos = castIntMaskToFloat(phasorResetMaskIntPos);
 
-		int32_4 phasorResetMaskIntNeg = (phasor + phaseInc) > phasor;
-		float_4 phasorResetMaskFloatNeg = castIntMaskToFloat(phasorResetMaskIntNeg);
+		TInt phasorResetMaskIntNeg = (phasor + phaseInc) > phasor;
+		T phasorResetMaskFloatNeg = castIntMaskToFloat(phasorResetMaskIntNeg);
 
 		return simd::ifelse(1.f * phaseInc > 0.f, phasorResetMaskFloatPos, phasorResetMaskFloatNeg);
 	}
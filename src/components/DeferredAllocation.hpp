@@ -0,0 +1,15 @@
+#pragma once
+
+namespace musx {
+
+/**
+ * For modules whose audio thread needs memory that depends on settings, e.g. delay lines.
+ * allocateAndFree() prepares the memory and frees what the audio thread has given back, the audio thread only swaps
+ * pointers. The module widget calls it in step(), the benchmark calls it while it renders.
+ */
+struct DeferredAllocation {
+	virtual ~DeferredAllocation() {}
+	virtual void allocateAndFree() = 0;
+};
+
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <rack.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+namespace musx {
+
+/**
+ * A small pool of persistent threads, which the audio thread can hand jobs to.
+ *
+ * submit() publishes the jobs through atomics, no locks are taken on the audio thread.
+ * Workers and the thread calling wait() claim jobs from a single atomic ticket, which holds the
+ * generation, the job count and the next index, so a late worker can never mix up the index of one
+ * submission with the count of the next. wait() runs the jobs nobody has started yet itself, and
+ * then spins until the others are finished.
+ * Idle workers yield, and back off to short sleeps when nothing has been submitted for a while.
+ */
+class WorkerPool {
+public:
+	typedef void (*Job)(void* context, int index);
+
+	~WorkerPool()
+	{
+		setThreads(0);
+	}
+
+	/** starts or stops threads, not real-time safe. Call it from outside the audio thread, jobs that are pending are left to wait() */
+	void setThreads(int n)
+	{
+		if (n == (int)threads.size())
+		{
+			return;
+		}
+
+		running = false;
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		threads.clear();
+
+		running = true;
+		for (int i = 0; i < n; i++)
+		{
+			threads.emplace_back(&WorkerPool::work, this);
+		}
+	}
+
+	int getThreads() const
+	{
+		return threads.size();
+	}
+
+	/** starts job(context, i) for i in [0, count), count < 65536. The previous jobs must be finished, see wait() */
+	void submit(Job job, void* context, int count)
+	{
+		// job and context are only read by whoever claims a valid index, which happens before wait() returns
+		this->job = job;
+		this->context = context;
+		submitted = count;
+		finished.store(0, std::memory_order_relaxed);
+		uint64_t generation = (ticket.load(std::memory_order_relaxed) >> 32) + 1;
+		ticket.store(generation << 32 | (uint64_t)count << 16, std::memory_order_release);
+	}
+
+	/** runs the remaining jobs on the calling thread and waits until all jobs are finished */
+	void wait()
+	{
+		runJobs();
+		while (finished.load(std::memory_order_acquire) < submitted)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+private:
+	std::vector<std::thread> threads;
+	std::atomic<bool> running{false};
+
+	Job job = nullptr;
+	void* context = nullptr;
+	int submitted = 0; // only used by the submitting thread
+	std::atomic<int> finished{0};
+	// generation << 32 | count << 16 | next index
+	std::atomic<uint64_t> ticket{0};
+
+	/** claims and runs jobs until the submission is exhausted, returns the generation of the last claim */
+	uint32_t runJobs()
+	{
+		while (true)
+		{
+			uint64_t claim = ticket.fetch_add(1, std::memory_order_acq_rel);
+			int index = claim & 0xffff;
+			int count = (claim >> 16) & 0xffff;
+			if (index >= count)
+			{
+				return claim >> 32;
+			}
+			job(context, index);
+			finished.fetch_add(1, std::memory_order_release);
+		}
+	}
+
+	void work()
+	{
+		// like the Rack engine threads
+		rack::random::init();
+#if defined(__SSE__)
+		_mm_setcsr(_mm_getcsr() | 0x8040); // flush denormals to zero
+#endif
+
+		uint32_t seen = ticket.load(std::memory_order_acquire) >> 32;
+		int idle = 0;
+		while (running)
+		{
+			if ((uint32_t)(ticket.load(std::memory_order_relaxed) >> 32) != seen)
+			{
+				seen = runJobs();
+				idle = 0;
+			}
+			else if (++idle < 10000)
+			{
+				std::this_thread::yield();
+			}
+			else
+			{
+				std::this_thread::sleep_for(std::chrono::microseconds(100));
+			}
+		}
+	}
+};
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <rack.hpp>
+#include <atomic>
 
 namespace musx {
 
@@ -52,7 +53,7 @@ struct TOnePole {
 		return tmp;
 	}
 
-	inline void processLowpassBlock(float_4* in, int oversamplingRate)
+	inline void processLowpassBlock(T* in, int oversamplingRate)
 	{
 		for (int i = 0; i < oversamplingRate; ++i)
 		{
@@ -61,7 +62,7 @@ struct TOnePole {
 		}
 	}
 
-	inline void processHighpassBlock(float_4* in, int oversamplingRate)
+	inline void processHighpassBlock(T* in, int oversamplingRate)
 	{
 		for (int i = 0; i < oversamplingRate; ++i)
 		{
@@ -322,7 +323,7 @@ struct AliasReductionFilter
 		f = clamp(f, 0.f, 0.5f);
 		for (size_t i = 0; i < O; i++)
 		{
-			filter[i].setParameters(dsp::TBiquadFilter<float_4>::LOWPASS, f, Q, 1.f);
+			filter[i].setParameters(dsp::TBiquadFilter<T>::LOWPASS, f, Q, 1.f);
 		}
 	}
 
@@ -331,6 +332,14 @@ struct AliasReductionFilter
 		setParameters(f);
 	}
 
+	void reset()
+	{
+		for (size_t i = 0; i < O; i++)
+		{
+			filter[i].reset();
+		}
+	}
+
 	T process(T in)
 	{
 		T out = in;
@@ -356,30 +365,130 @@ struct AliasReductionFilter
 };
 
 
+/**
+ * T vector type, float_4 or float_8
+ */
+template <typename T = float_4>
 struct CombFilter
 {
-	static const int delayLineSize = 2 << 16;
-	float_4 delayLine[delayLineSize] = {0};
+	static constexpr float minFreq = 20.f;
+	static const int maxDelayLineSize = 2 << 16;
+
+	// one sample of all lanes, without the alignment of T
+	struct Frame
+	{
+		float s[T::size];
+	};
+
+	typedef std::vector<Frame> DelayLine;
+
+	// The delay line is allocated and freed by updateDelayLine() outside the audio thread. It is handed over through
+	// pendingLine and back through retiredLine, one line at a time in each direction, so process() never allocates.
+	DelayLine* delayLine = nullptr; // only used by the thread that processes, silence while there is none
+	int delayLineSize = 0;
 	int index = 0;
+	std::atomic<int> requiredSize{0}; // for the sample time
+	std::atomic<bool> active{false}; // the line is only kept while the comb filter is in use
+	std::atomic<int> adoptedSize{0}; // delayLineSize, for updateDelayLine()
+	std::atomic<DelayLine*> pendingLine{nullptr};
+	std::atomic<DelayLine*> retiredLine{nullptr};
 
-	float_4 freq = 0;
-	float_4 feedback = 0;
+	T freq = 0;
+	T feedback = 0;
+
+	CombFilter() {}
+
+	~CombFilter()
+	{
+		delete delayLine;
+		delete pendingLine.load();
+		delete retiredLine.load();
+	}
+
+	CombFilter(const CombFilter&) = delete;
+	CombFilter& operator=(const CombFilter&) = delete;
+
+	/** Records the sample time dt (including oversampling), the line is sized for one period of minFreq. Does not allocate. */
+	void setSampleTime(float dt)
+	{
+		int size = 2;
+		int requiredFrames = (int)std::ceil(1.f / (dt * minFreq)) + 2;
+		while (size < requiredFrames && size < maxDelayLineSize)
+		{
+			size <<= 1;
+		}
+		requiredSize = size;
+	}
+
+	/** Whether the delay line is needed, it is freed while it is not */
+	void setActive(bool a)
+	{
+		active = a;
+	}
+
+	int getWantedSize()
+	{
+		return active ? requiredSize.load() : 0;
+	}
+
+	/**
+	 * Allocates the delay line that process() needs and frees the one it has given back.
+	 * Call it periodically outside the audio thread, never concurrently with itself.
+	 */
+	void updateDelayLine()
+	{
+		if (retiredLine.load())
+		{
+			delete retiredLine.exchange(nullptr);
+		}
+		int wantedSize = getWantedSize();
+		if (wantedSize > 0 && wantedSize != adoptedSize && !pendingLine.load())
+		{
+			pendingLine = new DelayLine(wantedSize);
+		}
+	}
+
+	/** Gives back a delay line of the wrong size and takes over a pending one, in the thread that processes */
+	void swapDelayLine()
+	{
+		if (delayLine && delayLineSize != getWantedSize() && !retiredLine.load())
+		{
+			retiredLine = delayLine;
+			delayLine = nullptr;
+			delayLineSize = 0;
+			adoptedSize = 0;
+		}
+		if (!delayLine && pendingLine.load())
+		{
+			delayLine = pendingLine.load();
+			delayLineSize = delayLine->size();
+			index = 0;
+			// before pendingLine is cleared, so that updateDelayLine() does not allocate the line again
+			adoptedSize = delayLineSize;
+			pendingLine = nullptr;
+		}
+	}
+
+	bool hasDelayLine() const
+	{
+		return delayLine != nullptr;
+	}
 
 	// set frequency in Hz
-	void setFreq(float_4 f)
+	void setFreq(T f)
 	{
-		freq = clamp(f, 20.f, 44000.f);
+		freq = clamp(f, minFreq, 44000.f);
 	}
 
 	// [0..5]
-	void setFeedback(float_4 f)
+	void setFeedback(T f)
 	{
 		feedback = 1.f - clamp(f, 0.f, 5.f) / 5.f;
 		feedback = feedback * feedback;
 		feedback = 1.0f - feedback;
 	}
 
-	void setNegativeFeedback(float_4 f)
+	void setNegativeFeedback(T f)
 	{
 		setFeedback(f);
 		feedback *= -1.f;
@@ -387,36 +496,42 @@ struct CombFilter
 
 	void reset()
 	{
-		std::memset(&delayLine, 0, delayLineSize * sizeof(float_4));
+		if (delayLine)
+		{
+			std::fill(delayLine->begin(), delayLine->end(), Frame());
+		}
 	}
 
-	// dt in seconds
-	float_4 process(float_4 in, float_4 dt)
+	// dt in seconds, frequencies below one period of the delay line are limited to it, see setSampleTime().
+	// Needs a delay line, see hasDelayLine()
+	T process(T in, T dt)
 	{
+		Frame* frames = delayLine->data();
+
 		// read from delay line
-		float_4 out = 0.f;
-		float_4 fractionalOffset = dt * freq;
+		T out = 0.f;
+		T fractionalOffset = dt * freq;
 		fractionalOffset = fmin(1.f / fractionalOffset, delayLineSize - 1);
 
 
-		for (size_t i = 0; i < 4; ++i)
+		for (int i = 0; i < T::size; ++i)
 		{
 			int offsetFloor = fractionalOffset[i];
 			int readIndex = index - offsetFloor - 1;
 			readIndex += (readIndex < 0) * delayLineSize;
 
-			out[i] = delayLine[readIndex][i];
+			out[i] = frames[readIndex].s[i];
 
 			int readIndex2 = readIndex + 1;
 			readIndex2 &= delayLineSize-1;
 
 			float frac = fractionalOffset[i] - offsetFloor;
 
-			out[i] = crossfade(delayLine[readIndex2][i], delayLine[readIndex][i], frac);
+			out[i] = crossfade(frames[readIndex2].s[i], frames[readIndex].s[i], frac);
 		}
 
 		// write to delay line
-		delayLine[index] = clamp(in + feedback * out , -100.f, 100.f);
+		T(clamp(in + feedback * out , -100.f, 100.f)).store(frames[index].s);
 
 		// advance index
 		++index;
@@ -0,0 +1,415 @@
+#pragma once
+
+#include <rack.hpp>
+
+/**
+ * 8 lane vectors for AVX2, with the operators and functions of Rack's float_4 that the blocks use.
+ * Only defined in translation units compiled with -mavx2 -mfma, which must be dispatched at runtime.
+ */
+
+#if defined(__AVX2__) && defined(__FMA__)
+
+#include <immintrin.h>
+
+namespace rack {
+namespace simd {
+
+template <>
+struct Vector<float, 8>;
+template <>
+struct Vector<int32_t, 8>;
+
+template <>
+struct Vector<float, 8> {
+	using type = float;
+	constexpr static int size = 8;
+
+	union {
+		__m256 v;
+		float s[8];
+	};
+
+	Vector() = default;
+	Vector(__m256 v) : v(v) {}
+	Vector(float x) { v = _mm256_set1_ps(x); }
+	Vector(float x1, float x2, float x3, float x4, float x5, float x6, float x7, float x8) { v = _mm256_setr_ps(x1, x2, x3, x4, x5, x6, x7, x8); }
+	Vector(Vector<float, 4> lo, Vector<float, 4> hi) { v = _mm256_set_m128(hi.v, lo.v); }
+
+	static Vector zero() { return Vector(_mm256_setzero_ps()); }
+	static Vector mask() { return Vector(_mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+	static Vector load(const float* x) { return Vector(_mm256_loadu_ps(x)); }
+	void store(float* x) { _mm256_storeu_ps(x, v); }
+
+	float& operator[](int i) { return s[i]; }
+	const float& operator[](int i) const { return s[i]; }
+
+	Vector(Vector<int32_t, 8> a);
+	static Vector cast(Vector<int32_t, 8> a);
+};
+
+template <>
+struct Vector<int32_t, 8> {
+	using type = int32_t;
+	constexpr static int size = 8;
+
+	union {
+		__m256i v;
+		int32_t s[8];
+	};
+
+	Vector() = default;
+	Vector(__m256i v) : v(v) {}
+	Vector(int32_t x) { v = _mm256_set1_epi32(x); }
+
+	static Vector zero() { return Vector(_mm256_setzero_si256()); }
+	static Vector mask() { return Vector(_mm256_set1_epi32(-1)); }
+	static Vector load(const int32_t* x) { return Vector(_mm256_loadu_si256((const __m256i*)x)); }
+	void store(int32_t* x) { _mm256_storeu_si256((__m256i*)x, v); }
+
+	int32_t& operator[](int i) { return s[i]; }
+	const int32_t& operator[](int i) const { return s[i]; }
+
+	Vector(Vector<float, 8> a);
+	static Vector cast(Vector<float, 8> a);
+};
+
+inline Vector<float, 8>::Vector(Vector<int32_t, 8> a)
+{
+	this->v = _mm256_cvtepi32_ps(a.v);
+}
+
+inline Vector<int32_t, 8>::Vector(Vector<float, 8> a)
+{
+	this->v = _mm256_cvttps_epi32(a.v);
+}
+
+inline Vector<float, 8> Vector<float, 8>::cast(Vector<int32_t, 8> a)
+{
+	return Vector(_mm256_castsi256_ps(a.v));
+}
+
+inline Vector<int32_t, 8> Vector<int32_t, 8>::cast(Vector<float, 8> a)
+{
+	return Vector(_mm256_castps_si256(a.v));
+}
+
+typedef Vector<float, 8> float_8;
+typedef Vector<int32_t, 8> int32_8;
+
+
+#define DECLARE_VECTOR8_OPERATOR_INFIX(t, operator, func) \
+	inline Vector<t, 8> operator(const Vector<t, 8>& a, const Vector<t, 8>& b) \
+	{ \
+		return Vector<t, 8>(func(a.v, b.v)); \
+	}
+
+#define DECLARE_VECTOR8_OPERATOR_INCREMENT(t, operator, opfunc) \
+	inline Vector<t, 8>& operator(Vector<t, 8>& a, const Vector<t, 8>& b) \
+	{ \
+		return a = opfunc(a, b); \
+	}
+
+#define DECLARE_VECTOR8_FLOAT_COMPARE(operator, predicate) \
+	inline Vector<float, 8> operator(const Vector<float, 8>& a, const Vector<float, 8>& b) \
+	{ \
+		return Vector<float, 8>(_mm256_cmp_ps(a.v, b.v, predicate)); \
+	}
+
+DECLARE_VECTOR8_OPERATOR_INFIX(float, operator+, _mm256_add_ps)
+DECLARE_VECTOR8_OPERATOR_INFIX(int32_t, operator+, _mm256_add_epi32)
+
+DECLARE_VECTOR8_OPERATOR_INFIX(float, operator-, _mm256_sub_ps)
+DECLARE_VECTOR8_OPERATOR_INFIX(int32_t, operator-, _mm256_sub_epi32)
+
+DECLARE_VECTOR8_OPERATOR_INFIX(float, operator*, _mm256_mul_ps)
+DECLARE_VECTOR8_OPERATOR_INFIX(float, operator/, _mm256_div_ps)
+
+DECLARE_VECTOR8_OPERATOR_INFIX(float, operator^, _mm256_xor_ps)
+DECLARE_VECTOR8_OPERATOR_INFIX(int32_t, operator^, _mm256_xor_si256)
+
+DECLARE_VECTOR8_OPERATOR_INFIX(float, operator&, _mm256_and_ps)
+DECLARE_VECTOR8_OPERATOR_INFIX(int32_t, operator&, _mm256_and_si256)
+
+DECLARE_VECTOR8_OPERATOR_INFIX(float, operator|, _mm256_or_ps)
+DECLARE_VECTOR8_OPERATOR_INFIX(int32_t, operator|, _mm256_or_si256)
+
+DECLARE_VECTOR8_OPERATOR_INCREMENT(float, operator+=, operator+)
+DECLARE_VECTOR8_OPERATOR_INCREMENT(int32_t, operator+=, operator+)
+DECLARE_VECTOR8_OPERATOR_INCREMENT(float, operator-=, operator-)
+DECLARE_VECTOR8_OPERATOR_INCREMENT(int32_t, operator-=, operator-)
+DECLARE_VECTOR8_OPERATOR_INCREMENT(float, operator*=, operator*)
+DECLARE_VECTOR8_OPERATOR_INCREMENT(float, operator/=, operator/)
+DECLARE_VECTOR8_OPERATOR_INCREMENT(float, operator^=, operator^)
+DECLARE_VECTOR8_OPERATOR_INCREMENT(int32_t, operator^=, operator^)
+DECLARE_VECTOR8_OPERATOR_INCREMENT(float, operator&=, operator&)
+DECLARE_VECTOR8_OPERATOR_INCREMENT(int32_t, operator&=, operator&)
+DECLARE_VECTOR8_OPERATOR_INCREMENT(float, operator|=, operator|)
+DECLARE_VECTOR8_OPERATOR_INCREMENT(int32_t, operator|=, operator|)
+
+// ordered comparisons, like the SSE ones of float_4, != is unordered
+DECLARE_VECTOR8_FLOAT_COMPARE(operator==, _CMP_EQ_OQ)
+DECLARE_VECTOR8_FLOAT_COMPARE(operator>=, _CMP_GE_OS)
+DECLARE_VECTOR8_FLOAT_COMPARE(operator>, _CMP_GT_OS)
+DECLARE_VECTOR8_FLOAT_COMPARE(operator<=, _CMP_LE_OS)
+DECLARE_VECTOR8_FLOAT_COMPARE(operator<, _CMP_LT_OS)
+DECLARE_VECTOR8_FLOAT_COMPARE(operator!=, _CMP_NEQ_UQ)
+
+DECLARE_VECTOR8_OPERATOR_INFIX(int32_t, operator==, _mm256_cmpeq_epi32)
+DECLARE_VECTOR8_OPERATOR_INFIX(int32_t, operator>, _mm256_cmpgt_epi32)
+
+inline Vector<int32_t, 8> operator<(const Vector<int32_t, 8>& a, const Vector<int32_t, 8>& b)
+{
+	return b > a;
+}
+
+inline Vector<int32_t, 8> operator>=(const Vector<int32_t, 8>& a, const Vector<int32_t, 8>& b)
+{
+	return (b > a) ^ Vector<int32_t, 8>::mask();
+}
+
+inline Vector<int32_t, 8> operator<=(const Vector<int32_t, 8>& a, const Vector<int32_t, 8>& b)
+{
+	return (a > b) ^ Vector<int32_t, 8>::mask();
+}
+
+inline Vector<int32_t, 8> operator!=(const Vector<int32_t, 8>& a, const Vector<int32_t, 8>& b)
+{
+	return (a == b) ^ Vector<int32_t, 8>::mask();
+}
+
+#undef DECLARE_VECTOR8_OPERATOR_INFIX
+#undef DECLARE_VECTOR8_OPERATOR_INCREMENT
+#undef DECLARE_VECTOR8_FLOAT_COMPARE
+
+template <typename T>
+Vector<T, 8> operator+(const Vector<T, 8>& a)
+{
+	return a;
+}
+
+template <typename T>
+Vector<T, 8> operator-(const Vector<T, 8>& a)
+{
+	return 0 - a;
+}
+
+inline Vector<float, 8> operator~(const Vector<float, 8>& a)
+{
+	return a ^ Vector<float, 8>::mask();
+}
+
+inline Vector<int32_t, 8> operator~(const Vector<int32_t, 8>& a)
+{
+	return a ^ Vector<int32_t, 8>::mask();
+}
+
+inline Vector<int32_t, 8> operator<<(const Vector<int32_t, 8>& a, const int& b)
+{
+	return Vector<int32_t, 8>(_mm256_slli_epi32(a.v, b));
+}
+
+inline Vector<int32_t, 8> operator>>(const Vector<int32_t, 8>& a, const int& b)
+{
+	return Vector<int32_t, 8>(_mm256_srli_epi32(a.v, b));
+}
+
+
+// functions
+
+inline float_8 fmax(float_8 x, float_8 b)
+{
+	return float_8(_mm256_max_ps(x.v, b.v));
+}
+
+inline float_8 fmin(float_8 x, float_8 b)
+{
+	return float_8(_mm256_min_ps(x.v, b.v));
+}
+
+inline float_8 sqrt(float_8 x)
+{
+	return float_8(_mm256_sqrt_ps(x.v));
+}
+
+inline float_8 abs(float_8 x)
+{
+	return x & float_8::cast(int32_8(0x7fffffff));
+}
+
+inline float_8 fabs(float_8 x)
+{
+	return abs(x);
+}
+
+inline float_8 floor(float_8 a)
+{
+	return float_8(_mm256_floor_ps(a.v));
+}
+
+inline float_8 ceil(float_8 a)
+{
+	return float_8(_mm256_ceil_ps(a.v));
+}
+
+inline float_8 round(float_8 a)
+{
+	return float_8(_mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+}
+
+inline float_8 trunc(float_8 a)
+{
+	return float_8(_mm256_round_ps(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+}
+
+inline float_8 fmod(float_8 a, float_8 b)
+{
+	return a - trunc(a / b) * b;
+}
+
+inline float_8 clamp(float_8 x, float_8 a = 0.f, float_8 b = 1.f)
+{
+	return fmin(fmax(x, a), b);
+}
+
+inline float_8 crossfade(float_8 a, float_8 b, float_8 p)
+{
+	return a + (b - a) * p;
+}
+
+inline float_8 sgn(float_8 x)
+{
+	float_8 signbit = x & -0.f;
+	float_8 nonzero = (x != 0.f);
+	return signbit | (nonzero & 1.f);
+}
+
+inline float_8 ifelse(float_8 mask, float_8 a, float_8 b)
+{
+	return float_8(_mm256_blendv_ps(b.v, a.v, mask.v));
+}
+
+inline int32_8 ifelse(int32_8 mask, int32_8 a, int32_8 b)
+{
+	return int32_8(_mm256_blendv_epi8(b.v, a.v, mask.v));
+}
+
+/** float results selected with an integer mask, e.g. phasor comparisons */
+inline float_8 ifelse(int32_8 mask, float_8 a, float_8 b)
+{
+	return ifelse(float_8::cast(mask), a, b);
+}
+
+/** integer results selected with a float mask, e.g. phasor resets */
+inline int32_8 ifelse(float_8 mask, int32_8 a, int32_8 b)
+{
+	return ifelse(int32_8::cast(mask), a, b);
+}
+
+inline int movemask(float_8 a)
+{
+	return _mm256_movemask_ps(a.v);
+}
+
+inline int movemask(int32_8 a)
+{
+	return _mm256_movemask_ps(_mm256_castsi256_ps(a.v));
+}
+
+/** Cephes style exp, the 8 lane version of sse_mathfun's exp_ps which Rack uses for float_4 */
+inline float_8 exp(float_8 x)
+{
+	x = fmin(x, 88.3762626647949f);
+	x = fmax(x, -88.3762626647949f);
+
+	// express exp(x) as exp(g + n*log(2))
+	float_8 fx = floor(x * 1.44269504088896341f + 0.5f);
+
+	x = x - fx * 0.693359375f;
+	x = x - fx * -2.12194440e-4f;
+
+	float_8 z = x * x;
+	float_8 y = 1.9875691500E-4f;
+	y = y * x + 1.3981999507E-3f;
+	y = y * x + 8.3334519073E-3f;
+	y = y * x + 4.1665795894E-2f;
+	y = y * x + 1.6666665459E-1f;
+	y = y * x + 5.0000001201E-1f;
+	y = y * z + x + 1.f;
+
+	// build 2^n
+	int32_8 emm0 = (int32_8(fx) + 0x7f) << 23;
+	return y * float_8::cast(emm0);
+}
+
+/** Cephes style natural log, the 8 lane version of sse_mathfun's log_ps */
+inline float_8 log(float_8 x)
+{
+	float_8 invalidMask = x <= 0.f;
+
+	// cut off denormalized stuff
+	x = fmax(x, float_8::cast(int32_8(0x00800000)));
+
+	int32_8 emm0 = int32_8::cast(x) >> 23;
+	// keep only the fractional part
+	x = x & float_8::cast(int32_8(~0x7f800000));
+	x = x | 0.5f;
+
+	float_8 e = float_8(emm0 - 0x7f) + 1.f;
+
+	float_8 mask = x < 0.707106781186547524f;
+	float_8 tmp = x & mask;
+	x = x - 1.f;
+	e = e - (mask & 1.f);
+	x = x + tmp;
+
+	float_8 z = x * x;
+	float_8 y = 7.0376836292E-2f;
+	y = y * x - 1.1514610310E-1f;
+	y = y * x + 1.1676998740E-1f;
+	y = y * x - 1.2420140846E-1f;
+	y = y * x + 1.4249322787E-1f;
+	y = y * x - 1.6668057665E-1f;
+	y = y * x + 2.0000714765E-1f;
+	y = y * x - 2.4999993993E-1f;
+	y = y * x + 3.3333331174E-1f;
+	y = y * x * z;
+
+	y = y + e * -2.12194440e-4f;
+	y = y - z * 0.5f;
+	x = x + y;
+	x = x + e * 0.693359375f;
+	// negative arg will be NAN
+	return x | invalidMask;
+}
+
+inline float_8 pow(float_8 a, float_8 b)
+{
+	return exp(b * log(a));
+}
+
+inline float_8 pow(float a, float_8 b)
+{
+	return exp(b * std::log(a));
+}
+
+} // namespace simd
+
+
+namespace dsp {
+
+template <>
+inline simd::float_8 approxExp2Floor(simd::float_8 x, simd::float_8* xf)
+{
+	simd::int32_8 xi = x;
+	if (xf)
+	{
+		*xf = x - simd::float_8(xi);
+	}
+	simd::int32_8 y = (xi + 127) << 23;
+	return simd::float_8::cast(y);
+}
+
+} // namespace dsp
+} // namespace rack
+
+#endif
@@ -2,6 +2,13 @@
 
 #include <rack.hpp>
 
+#include <cstring>
+
+// for small functions in inner loops, which GCC would otherwise call out of line, see odeFilters.hpp
+#ifndef MUSX_ALWAYS_INLINE
+#define MUSX_ALWAYS_INLINE inline __attribute__((always_inline))
+#endif
+
 namespace musx {
 
 using namespace rack;
@@ -33,7 +40,8 @@ inline T panGetVolR(T pan)
 	return fastCos((pan - 1.f) * 0.25f * M_PI);
 }
 
-inline float_4 waveshape(float_4 in)
+template <typename T = float_4>
+inline T waveshape(T in)
 {
 	static const float a = {1.f/8.f};
 	static const float b = {1.f/18.f};
@@ -42,7 +50,8 @@ inline float_4 waveshape(float_4 in)
 }
 
 // y_max = +-1
-inline float_4 tanh(float_4 x)
+template <typename T = float_4>
+MUSX_ALWAYS_INLINE T tanh(T x)
 {
 	// Pade approximant of tanh
 	x = simd::clamp(x, -3.f, 3.f);
@@ -50,7 +59,8 @@ inline float_4 tanh(float_4 x)
 }
 
 // y_max = +-10
-inline float_4 cheapSaturator(float_4 x)
+template <typename T = float_4>
+inline T cheapSaturator(T x)
 {
 	x = simd::clamp(x, -15.f, 15.f);
 	return x - 1.f/675.f * x*x*x;
@@ -80,6 +90,11 @@ private:
 	}
 
 public:
+	void reset()
+	{
+		x = 0;
+	}
+
 	T process(T in)
 	{
 		return processBandlimited(in);
@@ -142,16 +157,117 @@ struct TSlewLimiter {
 	}
 };
 
-static inline float_4 castIntMaskToFloat(int32_4 maskInt)
+template <typename T>
+struct IntVector {
+	typedef int32_t type;
+};
+
+template <int N>
+struct IntVector<simd::Vector<float, N>> {
+	typedef simd::Vector<int32_t, N> type;
+};
+
+inline float bitsToFloat(int32_t i)
+{
+	float f;
+	std::memcpy(&f, &i, sizeof(f));
+	return f;
+}
+
+template <int N>
+inline simd::Vector<float, N> bitsToFloat(simd::Vector<int32_t, N> i)
+{
+	return simd::Vector<float, N>::cast(i);
+}
+
+/**
+ * 2^x for float, float_4 and float_8, for pitch, cutoff and envelope times.
+ * Range reduction to [-0.5, 0.5] and a degree 5 minimax polynomial.
+ * Max. relative error 2.3e-7, i.e. 0.0004 cents. x is clamped to [-126, 127].
+ * Benchmark against simd::exp and dsp::exp2_taylor5 with `build/bench exp`.
+ */
+template <typename T>
+inline T fastExp2(T x)
+{
+	typedef typename IntVector<T>::type I;
+
+	x = simd::fmin(simd::fmax(x, T(-126.f)), T(127.f));
+	// round to nearest, the offset keeps the truncation positive
+	I xi = I(x + T(127.5f)) - I(127);
+	T xf = x - T(xi);
+
+	T y = T(1.3276472e-3f);
+	y = y * xf + T(9.6755413e-3f);
+	y = y * xf + T(5.5507133e-2f);
+	y = y * xf + T(2.4022120e-1f);
+	y = y * xf + T(6.9314697e-1f);
+	y = y * xf + T(1.0000001f);
+
+	return y * bitsToFloat((xi + I(127)) << 23);
+}
+
+/** e^x with fastExp2(), same relative error, for x in [-87, 88] */
+template <typename T>
+inline T fastExp(T x)
+{
+	return fastExp2(x * T(1.4426950408889634f));
+}
+
+/** the sums of the lanes of a, b, c and d, in one vector */
+inline float_4 sumLanes(float_4 a, float_4 b, float_4 c, float_4 d)
+{
+	_MM_TRANSPOSE4_PS(a.v, b.v, c.v, d.v);
+	return a + b + c + d;
+}
+
+/** for float_8, the upper and lower halves are added first */
+template <int N>
+inline float_4 sumLanes(simd::Vector<float, N> a, simd::Vector<float, N> b, simd::Vector<float, N> c, simd::Vector<float, N> d)
+{
+	float_4 a4 = 0.f, b4 = 0.f, c4 = 0.f, d4 = 0.f;
+	for (int i = 0; i < N; i += 4)
+	{
+		a4 += float_4::load(&a[i]);
+		b4 += float_4::load(&b[i]);
+		c4 += float_4::load(&c[i]);
+		d4 += float_4::load(&d[i]);
+	}
+	return sumLanes(a4, b4, c4, d4);
+}
+
+/**
+ * index of the oversampling rates 1, 2, 4, 8 and 16 in a table of code specialized on the rate,
+ * every other rate gets the last index, for code that takes the rate at runtime
+ */
+inline int getOversamplingRateIndex(int oversamplingRate)
+{
+	switch (oversamplingRate)
+	{
+	case 1:
+		return 0;
+	case 2:
+		return 1;
+	case 4:
+		return 2;
+	case 8:
+		return 3;
+	case 16:
+		return 4;
+	default:
+		return 5;
+	}
+}
+
+template <int N>
+static inline simd::Vector<float, N> castIntMaskToFloat(simd::Vector<int32_t, N> maskInt)
 {
-	void* tmp = &maskInt;
-	return *(float_4*)tmp;
+	return simd::Vector<float, N>::cast(maskInt);
 }
 
-static inline int32_4 castFloatMaskToInt(float_4 maskFloat)
+template <int N>
+static inline simd::Vector<int32_t, N> castFloatMaskToInt(simd::Vector<float, N> maskFloat)
 {
-	void* tmp = &maskFloat;
-	return *(int32_4*)tmp;
+	return simd::Vector<int32_t, N>::cast(maskFloat);
 }
 
 }
@@ -5,6 +5,14 @@
  * A lot of code is copied and adapted from Rack Fundamental (VCF.cpp) and Rack-SDK (ode.hpp)
  */
 
+// The derivative functions f() and their helpers are evaluated up to 4 times per step. Without forcing it,
+// GCC stops inlining them into the solvers, and the solvers into the kernels of FilterBlock. Since the solvers
+// are templates, every module gets a weak copy of them, and the linker may keep one that is not inlined.
+// MUSX_ALWAYS_INLINE is defined in functions.hpp.
+#ifndef MUSX_NOINLINE
+#define MUSX_NOINLINE __attribute__((noinline))
+#endif
+
 namespace musx {
 
 using namespace rack;
@@ -33,40 +41,62 @@ enum struct IntegratorType
 	Transistor_alt,
 };
 
+/**
+ * State that is handed over when switching between filters, see FilterAbstract::exportState()
+ */
+template <typename T>
+struct FilterState
+{
+	static const size_t maxSize = 4;
+	T state[maxSize] = {};
+	size_t size = 0;
+	T input = 0;
+	T lastInput = 0;
+	T omega0 = 0;
+	T resonance = 0;
+};
+
 /**
  * S is size of state vector
+ *
+ * Derived implements the ODE system as
+ *   void f(T t, const T x[], T dxdt[]) const
+ * which is called statically (CRTP), so it can be inlined into the solvers.
  */
-template <typename T, size_t S, IntegratorType integratorType = IntegratorType::Transistor_tanh>
+template <typename Derived, typename T, size_t S, IntegratorType integratorType>
 class FilterAbstract {
 protected:
 	T omega0;
 	T resonance = 0;
 	T state[S];
-	T lastInput;
-	T input;
-	T dt;
+	T lastInput = 0;
+	T input = 0;
+	T dt = 0;
 	const T maxAmplitude = 12.f;
 	
 	Method method = Method::RK4;
 
-	virtual void f(T t, const T x[], T dxdt[]) const = 0;
+	const Derived& derived() const
+	{
+		return *static_cast<const Derived*>(this);
+	}
 
-	T clip(T x) const
+	MUSX_ALWAYS_INLINE T clip(T x) const
 	{
 		return maxAmplitude * musx::tanh(x/maxAmplitude);
 	}
 
-	T clipAlt(T x) const
+	MUSX_ALWAYS_INLINE T clipAlt(T x) const
 	{
 		return musx::AntialiasedCheapSaturator<T>::processNonBandlimited(x);
 	}
 
-	T getInputt(T t) const
+	MUSX_ALWAYS_INLINE T getInputt(T t) const
 	{
 		return crossfade(this->lastInput, this->input, t / this->dt);
 	}
 	
-	void calcLowpass(T in, size_t iStage, const T x[], T dxdt[]) const
+	MUSX_ALWAYS_INLINE void calcLowpass(T in, size_t iStage, const T x[], T dxdt[]) const
 	{
 		switch (integratorType)
 		{
@@ -89,7 +119,7 @@ protected:
 		}
 	}
 
-	void calcLowpassInverting(T in, size_t iStage, const T x[], T dxdt[]) const
+	MUSX_ALWAYS_INLINE void calcLowpassInverting(T in, size_t iStage, const T x[], T dxdt[]) const
 	{
 		switch (integratorType)
 		{
@@ -108,7 +138,7 @@ protected:
 		}
 	}
 
-	void calcHighpass(T in, size_t iStage, const T x[], T dxdt[]) const
+	MUSX_ALWAYS_INLINE void calcHighpass(T in, size_t iStage, const T x[], T dxdt[]) const
 	{
 		switch (integratorType)
 		{
@@ -128,10 +158,10 @@ protected:
 	}
 
 	/** Solves an ODE system using the 1st order Euler method */
-	void stepEuler(T t) {
+	MUSX_ALWAYS_INLINE void stepEuler(T t) {
 		T k[S];
 
-		f(t, state, k);
+		derived().f(t, state, k);
 
 		for (size_t i = 0; i < S; i++) {
 			state[i] += dt * k[i];
@@ -139,17 +169,17 @@ protected:
 	}
 
 	/** Solves an ODE system using the 2nd order Runge-Kutta method */
-	void stepRK2(T t) {
+	MUSX_ALWAYS_INLINE void stepRK2(T t) {
 		T k1[S];
 		T k2[S];
 		T yi[S];
 
-		f(t, state, k1);
+		derived().f(t, state, k1);
 
 		for (size_t i = 0; i < S; i++) {
 			yi[i] = state[i] + k1[i] * dt / T(2);
 		}
-		f(t + dt / T(2), yi, k2);
+		derived().f(t + dt / T(2), yi, k2);
 
 		for (size_t i = 0; i < S; i++) {
 			state[i] += dt * k2[i];
@@ -157,29 +187,29 @@ protected:
 	}
 
 	/** Solves an ODE system using the 4th order Runge-Kutta method */
-	void stepRK4(T t) {
+	MUSX_ALWAYS_INLINE void stepRK4(T t) {
 		T k1[S];
 		T k2[S];
 		T k3[S];
 		T k4[S];
 		T yi[S];
 
-		f(t, state, k1);
+		derived().f(t, state, k1);
 
 		for (size_t i = 0; i < S; i++) {
 			yi[i] = state[i] + k1[i] * dt / T(2);
 		}
-		f(t + dt / T(2), yi, k2);
+		derived().f(t + dt / T(2), yi, k2);
 
 		for (size_t i = 0; i < S; i++) {
 			yi[i] = state[i] + k2[i] * dt / T(2);
 		}
-		f(t + dt / T(2), yi, k3);
+		derived().f(t + dt / T(2), yi, k3);
 
 		for (size_t i = 0; i < S; i++) {
 			yi[i] = state[i] + k3[i] * dt;
 		}
-		f(t + dt, yi, k4);
+		derived().f(t + dt, yi, k4);
 
 		for (size_t i = 0; i < S; i++) {
 			state[i] += dt * (k1[i] + T(2) * k2[i] + T(2) * k3[i] + k4[i]) / T(6);
@@ -212,6 +242,33 @@ public:
 		method = m;
 	}
 
+	void exportState(FilterState<T>& s) const
+	{
+		s.size = S < FilterState<T>::maxSize ? S : FilterState<T>::maxSize;
+		for (size_t i = 0; i < s.size; i++) {
+			s.state[i] = state[i];
+		}
+		s.input = input;
+		s.lastInput = lastInput;
+		s.omega0 = omega0;
+		s.resonance = resonance;
+	}
+
+	/**
+	 * Takes over the state of another filter, possibly of a different type.
+	 * The capacitor voltages are mapped by index, additional stages start at 0.
+	 */
+	void importState(const FilterState<T>& s)
+	{
+		for (size_t i = 0; i < S; i++) {
+			state[i] = i < s.size ? s.state[i] : T(0);
+		}
+		input = s.input;
+		lastInput = s.lastInput;
+		omega0 = s.omega0;
+		resonance = s.resonance;
+	}
+
 	/**
 	 * cutoff is Hz
 	 */
@@ -248,7 +305,7 @@ public:
 		this->lastInput = input;
 	}
 
-	void processEuler(T input, T dt)
+	MUSX_ALWAYS_INLINE void processEuler(T input, T dt)
 	{
 		this->input = input;
 		this->dt = dt;
@@ -256,7 +313,7 @@ public:
 		this->lastInput = input;
 	}
 
-	void processRK2(T input, T dt)
+	MUSX_ALWAYS_INLINE void processRK2(T input, T dt)
 	{
 		this->input = input;
 		this->dt = dt;
@@ -264,7 +321,7 @@ public:
 		this->lastInput = input;
 	}
 
-	void processRK4(T input, T dt)
+	MUSX_ALWAYS_INLINE void processRK4(T input, T dt)
 	{
 		this->input = input;
 		this->dt = dt;
@@ -276,10 +333,12 @@ public:
 
 
 template <typename T, IntegratorType integratorType = IntegratorType::Transistor_tanh>
-class Filter1Pole : public FilterAbstract<T, 1, integratorType>
+class Filter1Pole : public FilterAbstract<Filter1Pole<T, integratorType>, T, 1, integratorType>
 {
+	friend class FilterAbstract<Filter1Pole<T, integratorType>, T, 1, integratorType>;
+
 protected:
-	void f(T t, const T x[], T dxdt[]) const override
+	MUSX_ALWAYS_INLINE void f(T t, const T x[], T dxdt[]) const
 	{
 		T input = this->getInputt(t);
 		input = clamp(input, -this->maxAmplitude, this->maxAmplitude);
@@ -300,10 +359,12 @@ public:
 };
 
 template <typename T, IntegratorType integratorType = IntegratorType::Transistor_tanh>
-class LadderFilter2Pole : public FilterAbstract<T, 2, integratorType>
+class LadderFilter2Pole : public FilterAbstract<LadderFilter2Pole<T, integratorType>, T, 2, integratorType>
 {
+	friend class FilterAbstract<LadderFilter2Pole<T, integratorType>, T, 2, integratorType>;
+
 protected:
-	void f(T t, const T x[], T dxdt[]) const override
+	MUSX_ALWAYS_INLINE void f(T t, const T x[], T dxdt[]) const
 	{
 		T input = this->getInputt(t) - this->resonance * x[1]; // negative feedback
 		input = clamp(input, -this->maxAmplitude, this->maxAmplitude);
@@ -325,10 +386,12 @@ public:
 };
 
 template <typename T, IntegratorType integratorType = IntegratorType::Transistor_tanh>
-class LadderFilter4Pole : public FilterAbstract<T, 4, integratorType>
+class LadderFilter4Pole : public FilterAbstract<LadderFilter4Pole<T, integratorType>, T, 4, integratorType>
 {
+	friend class FilterAbstract<LadderFilter4Pole<T, integratorType>, T, 4, integratorType>;
+
 protected:
-	void f(T t, const T x[], T dxdt[]) const override
+	MUSX_ALWAYS_INLINE void f(T t, const T x[], T dxdt[]) const
 	{
 		T input = this->getInputt(t) - T(2.) * this->resonance * x[3]; // negative feedback
 		input = clamp(input, -this->maxAmplitude, this->maxAmplitude);
@@ -363,10 +426,12 @@ public:
 };
 
 template <typename T, IntegratorType integratorType = IntegratorType::Transistor_tanh>
-class SallenKeyFilterLpBp : public FilterAbstract<T, 2, integratorType>
+class SallenKeyFilterLpBp : public FilterAbstract<SallenKeyFilterLpBp<T, integratorType>, T, 2, integratorType>
 {
+	friend class FilterAbstract<SallenKeyFilterLpBp<T, integratorType>, T, 2, integratorType>;
+
 protected:
-	void f(T t, const T x[], T dxdt[]) const override
+	MUSX_ALWAYS_INLINE void f(T t, const T x[], T dxdt[]) const
 	{
 		T hp1 = x[0] - x[1];
 		T input = this->getInputt(t) + this->resonance * hp1; // positive feedback
@@ -393,10 +458,12 @@ public:
 };
 
 template <typename T, IntegratorType integratorType = IntegratorType::Transistor_tanh>
-class SallenKeyFilterHp : public FilterAbstract<T, 2, integratorType>
+class SallenKeyFilterHp : public FilterAbstract<SallenKeyFilterHp<T, integratorType>, T, 2, integratorType>
 {
+	friend class FilterAbstract<SallenKeyFilterHp<T, integratorType>, T, 2, integratorType>;
+
 protected:
-	void f(T t, const T x[], T dxdt[]) const override
+	MUSX_ALWAYS_INLINE void f(T t, const T x[], T dxdt[]) const
 	{
 		T input = this->getInputt(t) + T(0.8) * this->resonance * x[1]; // positive feedback
 		input = clamp(input, -this->maxAmplitude, this->maxAmplitude);
@@ -418,17 +485,20 @@ public:
 };
 
 template <typename T, IntegratorType integratorType = IntegratorType::Transistor_tanh>
-class DiodeClipper : public FilterAbstract<T, 1, integratorType>
+class DiodeClipper : public FilterAbstract<DiodeClipper<T, integratorType>, T, 1, integratorType>
 {
+	friend class FilterAbstract<DiodeClipper<T, integratorType>, T, 1, integratorType>;
+
 protected:
-	void f(T t, const T x[], T dxdt[]) const override
+	// keeps the exponentials inlined, which does not happen if this gets inlined into the solvers
+	MUSX_NOINLINE void f(T t, const T x[], T dxdt[]) const
 	{
 		// resonance = drive
 		T mult = T(0.5) + T(0.4) * this->resonance * this->resonance;
 		T input = mult * this->getInputt(t);
 
-		static const T a = {1.e-6};
-		static const T b = 0.3 * this->maxAmplitude;
+		const T a = 1.e-6f;
+		const T b = 0.3f * this->maxAmplitude;
 
 		T dxdtCap = this->omega0 * (input - x[0]); // dxdt of the capacitor
 
@@ -448,17 +518,20 @@ public:
 };
 
 template <typename T, IntegratorType integratorType = IntegratorType::Transistor_tanh>
-class DiodeClipperAsym : public FilterAbstract<T, 2, integratorType>
+class DiodeClipperAsym : public FilterAbstract<DiodeClipperAsym<T, integratorType>, T, 2, integratorType>
 {
+	friend class FilterAbstract<DiodeClipperAsym<T, integratorType>, T, 2, integratorType>;
+
 protected:
-	void f(T t, const T x[], T dxdt[]) const override
+	// keeps the exponentials inlined, which does not happen if this gets inlined into the solvers
+	MUSX_NOINLINE void f(T t, const T x[], T dxdt[]) const
 	{
 		// resonance = drive
 		T mult = T(0.5) + T(0.4) * this->resonance * this->resonance;
 		T input = mult * this->getInputt(t);
 
-		static const T a = {1.e-6};
-		static const T b = 0.3 * this->maxAmplitude;
+		const T a = 1.e-6f;
+		const T b = 0.3f * this->maxAmplitude;
 
 		T dxdtCap = this->omega0 * (input - x[0]); // dxdt of the capacitor
 
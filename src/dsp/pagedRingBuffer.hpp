@@ -0,0 +1,251 @@
+#pragma once
+
+#include <rack.hpp>
+#include <atomic>
+#include <vector>
+
+namespace musx {
+
+using namespace rack;
+
+/**
+ * Pages for TPagedRingBuffer, allocated and freed outside the audio thread.
+ * refill() keeps a reserve of zeroed pages ready and frees the pages that were given back. take() and give() only pass
+ * pointers through lock-free queues for one producer and one consumer thread, so they can be called in the audio thread.
+ *
+ * T float or float_4 (new does not guarantee the alignment of float_8 before C++17)
+ */
+template <typename T>
+class TPagePool {
+public:
+	static constexpr int pageBits = 10;
+	static constexpr int pageSize = 1 << pageBits;
+
+private:
+	// capacity a power of 2
+	class Queue {
+		std::vector<T*> slots;
+		std::atomic<size_t> head{0}; // next slot to pop
+		std::atomic<size_t> tail{0}; // next slot to push
+
+	public:
+		explicit Queue(size_t capacity) : slots(capacity) {}
+
+		bool push(T* page)
+		{
+			size_t t = tail.load(std::memory_order_relaxed);
+			if (t - head.load(std::memory_order_acquire) == slots.size())
+			{
+				return false;
+			}
+			slots[t & (slots.size() - 1)] = page;
+			tail.store(t + 1, std::memory_order_release);
+			return true;
+		}
+
+		T* pop()
+		{
+			size_t h = head.load(std::memory_order_relaxed);
+			if (h == tail.load(std::memory_order_acquire))
+			{
+				return nullptr;
+			}
+			T* page = slots[h & (slots.size() - 1)];
+			head.store(h + 1, std::memory_order_release);
+			return page;
+		}
+	};
+
+	Queue fresh;
+	Queue retired;
+	int reserve;
+
+	static size_t powerOf2AtLeast(size_t n)
+	{
+		size_t size = 1;
+		while (size < n)
+		{
+			size <<= 1;
+		}
+		return size;
+	}
+
+public:
+	/**
+	 * reserve pages are kept ready for take(), maxPages is the most pages that all ring buffers of the pool can hold,
+	 * so that give() always has room for them.
+	 */
+	TPagePool(int reserve, int maxPages) :
+		fresh(powerOf2AtLeast(reserve)),
+		retired(powerOf2AtLeast(maxPages + reserve)),
+		reserve(reserve)
+	{
+	}
+
+	~TPagePool()
+	{
+		while (T* page = fresh.pop())
+		{
+			delete[] page;
+		}
+		while (T* page = retired.pop())
+		{
+			delete[] page;
+		}
+	}
+
+	TPagePool(const TPagePool&) = delete;
+	TPagePool& operator=(const TPagePool&) = delete;
+
+	/** frees the pages that were given back and fills up the reserve, outside the audio thread */
+	void refill()
+	{
+		while (T* page = retired.pop())
+		{
+			delete[] page;
+		}
+		for (int i = 0; i < reserve; i++)
+		{
+			T* page = new T[pageSize]();
+			if (!fresh.push(page))
+			{
+				delete[] page;
+				break;
+			}
+		}
+	}
+
+	/** a zeroed page, nullptr if the reserve is used up */
+	T* take()
+	{
+		return fresh.pop();
+	}
+
+	/** hands a page back to be freed by refill() */
+	void give(T* page)
+	{
+		retired.push(page);
+	}
+};
+
+/**
+ * Ring buffer with a power of 2 size, split into pages that are taken from a TPagePool when they are written for the
+ * first time. Pages that were never written read as 0, and pages beyond the size are given back when it shrinks,
+ * so the memory follows the size that is actually used, and not the largest possible size.
+ * Only setPagePool() allocates, the other methods can be called in the audio thread.
+ *
+ * T float or float_4 (new does not guarantee the alignment of float_8 before C++17)
+ */
+template <typename T>
+class TPagedRingBuffer {
+public:
+	static constexpr int pageBits = TPagePool<T>::pageBits;
+	static constexpr int pageSize = TPagePool<T>::pageSize;
+
+private:
+	std::vector<T*> pages; // for the largest size, nullptr for pages that were not written yet
+	int usedPages = 0;
+	int size = 0;
+	TPagePool<T>* pagePool = nullptr;
+
+public:
+	TPagedRingBuffer() {}
+
+	~TPagedRingBuffer()
+	{
+		for (T* page : pages)
+		{
+			delete[] page;
+		}
+	}
+
+	TPagedRingBuffer(const TPagedRingBuffer&) = delete;
+	TPagedRingBuffer& operator=(const TPagedRingBuffer&) = delete;
+
+	/** the pool that pages are taken from and given back to, and the largest size that resize() is called with */
+	void setPagePool(TPagePool<T>* pool, int maxSize)
+	{
+		pagePool = pool;
+		pages.resize((maxSize + pageSize - 1) / pageSize);
+	}
+
+	/** size must be a power of 2 up to the size given to setPagePool(), the content below the new size is kept */
+	void resize(int newSize)
+	{
+		size = newSize;
+		usedPages = (size + pageSize - 1) / pageSize;
+		for (int p = usedPages; p < (int)pages.size(); p++)
+		{
+			release(p);
+		}
+	}
+
+	int getSize() const
+	{
+		return size;
+	}
+
+	/** gives back all pages */
+	void clear()
+	{
+		for (int p = 0; p < (int)pages.size(); p++)
+		{
+			release(p);
+		}
+	}
+
+	T read(int i) const
+	{
+		const T* page = pages[i >> pageBits];
+		return page ? page[i & (pageSize - 1)] : T(0);
+	}
+
+	/** the write is dropped if the page is not there yet and the pool is empty, it reads as 0 until the next round */
+	void write(int i, T x)
+	{
+		T*& page = pages[i >> pageBits];
+		if (!page)
+		{
+			page = pagePool->take();
+			if (!page)
+			{
+				return;
+			}
+		}
+		page[i & (pageSize - 1)] = x;
+	}
+
+	/** nullptr if page p was not written yet */
+	T* getPage(int p)
+	{
+		return pages[p];
+	}
+
+	int getPages() const
+	{
+		return usedPages;
+	}
+
+	/** allocated bytes */
+	size_t getMemory() const
+	{
+		size_t memory = 0;
+		for (const T* page : pages)
+		{
+			memory += page ? pageSize * sizeof(T) : 0;
+		}
+		return memory;
+	}
+
+private:
+	void release(int p)
+	{
+		if (pages[p])
+		{
+			pagePool->give(pages[p]);
+			pages[p] = nullptr;
+		}
+	}
+};
+
+}
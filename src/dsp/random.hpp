@@ -0,0 +1,132 @@
+#pragma once
+
+#include <rack.hpp>
+#include <cmath>
+#include "functions.hpp"
+
+namespace musx {
+
+using namespace rack;
+using simd::float_4;
+
+/**
+ * xoshiro128+ in every lane, see https://prng.di.unimi.it/
+ * Each lane is an independent generator, so one call gives a random value per voice.
+ * Seed it per module instance, e.g. with the module id, to get the same noise when a patch is loaded again.
+ *
+ * T vector type, float_4 or float_8
+ */
+template <typename T>
+class TRandom {
+private:
+	typedef typename IntVector<T>::type I;
+
+	// state, >> of the int vectors is a logical shift
+	I s0, s1, s2, s3;
+
+	static constexpr int normalTableBits = 12;
+
+	static uint64_t splitMix64(uint64_t& x)
+	{
+		uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+
+	static I rotl(I x, int k)
+	{
+		return (x << k) | (x >> (32 - k));
+	}
+
+	/** the 4096 equiprobable quantiles of the standard normal distribution */
+	struct NormalTable {
+		float values[1 << normalTableBits];
+
+		NormalTable()
+		{
+			for (int i = 0; i < (1 << normalTableBits); i++)
+			{
+				// Newton's method on the CDF, 0.5 * erfc(-x / sqrt(2))
+				double p = (i + 0.5) / (1 << normalTableBits);
+				double x = 0.;
+				for (int iteration = 0; iteration < 50; iteration++)
+				{
+					double cdf = 0.5 * std::erfc(-x * M_SQRT1_2);
+					double pdf = std::exp(-0.5 * x * x) / std::sqrt(2. * M_PI);
+					double dx = (cdf - p) / pdf;
+					x -= dx;
+					if (std::fabs(dx) < 1e-9)
+					{
+						break;
+					}
+				}
+				values[i] = x;
+			}
+		}
+	};
+
+	static const float* getNormalTable()
+	{
+		// thread safe initialization, and the constructor of TRandom initializes it before the first process()
+		static const NormalTable table;
+		return table.values;
+	}
+
+public:
+	TRandom()
+	{
+		seed(0x3243f6a8885a308dULL);
+		getNormalTable();
+	}
+
+	void seed(uint64_t s, uint64_t stream = 0)
+	{
+		uint64_t x = s ^ (stream * 0xd1342543de82ef95ULL);
+		for (I* state : {&s0, &s1, &s2, &s3})
+		{
+			for (int i = 0; i < T::size; i++)
+			{
+				(*state)[i] = splitMix64(x) >> 32;
+			}
+		}
+	}
+
+	I next()
+	{
+		I result = s0 + s3;
+		I t = s1 << 9;
+
+		s2 ^= s0;
+		s3 ^= s1;
+		s1 ^= s2;
+		s0 ^= s3;
+		s2 ^= t;
+		s3 = rotl(s3, 11);
+
+		return result;
+	}
+
+	/** [0..1), from the upper 24 bits, the lowest bits of xoshiro128+ are weak */
+	T uniform()
+	{
+		return T(next() >> 8) * T(1.f / (1 << 24));
+	}
+
+	/** standard normal distribution, looked up in a table of 4096 quantiles, so it is limited to +-3.7 */
+	T normal()
+	{
+		const float* table = getNormalTable();
+		I index = next() >> (32 - normalTableBits);
+		T y;
+		for (int i = 0; i < T::size; i++)
+		{
+			y[i] = table[index[i]];
+		}
+		return y;
+	}
+};
+
+typedef TRandom<float_4> Random;
+
+}
@@ -21,6 +21,7 @@ void init(Plugin* p) {
 	p->addModel(modelOnePoleLP);
 	p->addModel(modelOscillators);
 	p->addModel(modelSplitStack);
+	p->addModel(modelSplitStackExpander);
 	p->addModel(modelSynth);
 	p->addModel(modelTuner);
 
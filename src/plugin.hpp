@@ -20,6 +20,7 @@ extern Model* modelOnePole;
 extern Model* modelOnePoleLP;
 extern Model* modelOscillators;
 extern Model* modelSplitStack;
+extern Model* modelSplitStackExpander;
 extern Model* modelSynth;
 extern Model* modelTuner;
 